@@ -0,0 +1,273 @@
+//
+// Created by YJK on 2026/10/16.
+//
+
+// base64 向量化编解码的校验与基准工具（-DBUILD_BASE64_BENCH=ON 时构建）
+// 以逐字节的标量编码器为参照比对 base64_encode（含 24/48 字节块边界附近的各种尾部长度），
+// 以逐块的标量解码器为参照，在随机输入、各种填充形式和损坏输入上交叉比对
+// base64_decode / base64_decode_into / base64_simd::decode，再分别计时两者的解码吞吐
+
+#include "common/base64.h"
+#include "common/base64_simd.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+    unsigned int scalarPosOfChar(unsigned char chr) {
+        if (chr >= 'A' && chr <= 'Z') return chr - 'A';
+        if (chr >= 'a' && chr <= 'z') return chr - 'a' + 26;
+        if (chr >= '0' && chr <= '9') return chr - '0' + 52;
+        if (chr == '+' || chr == '-') return 62;
+        if (chr == '/' || chr == '_') return 63;
+        throw std::runtime_error("Input is not valid base64-encoded data.");
+    }
+
+    /**
+     * @brief 参照解码器：与引入向量化之前的逐块标量实现语义一致
+     * （两种字母表都接受，末块可用 '=' 或 '.' 填充，也可不填充）
+     */
+    std::string scalarDecode(std::string_view s) {
+        std::string out;
+        out.reserve(s.size() / 4 * 3);
+
+        size_t pos = 0;
+        while (pos < s.size()) {
+            if (pos + 1 >= s.size()) {
+                throw std::runtime_error("Input is not valid base64-encoded data.");
+            }
+            unsigned int c1 = scalarPosOfChar(s[pos + 1]);
+            out.push_back(static_cast<char>((scalarPosOfChar(s[pos]) << 2) + ((c1 & 0x30) >> 4)));
+
+            if (pos + 2 < s.size() && s[pos + 2] != '=' && s[pos + 2] != '.') {
+                unsigned int c2 = scalarPosOfChar(s[pos + 2]);
+                out.push_back(static_cast<char>(((c1 & 0x0f) << 4) + ((c2 & 0x3c) >> 2)));
+
+                if (pos + 3 < s.size() && s[pos + 3] != '=' && s[pos + 3] != '.') {
+                    out.push_back(static_cast<char>(((c2 & 0x03) << 6) + scalarPosOfChar(s[pos + 3])));
+                }
+            }
+            pos += 4;
+        }
+        return out;
+    }
+
+    /**
+     * @brief 参照编码器：逐3字节查表，末块按 url 用 '=' 或 '.' 填充，不经过向量化路径
+     */
+    std::string scalarEncode(const std::string& bytes, bool url) {
+        const char* chars = url ? "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_"
+                                : "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        const char trailing = url ? '.' : '=';
+
+        std::string out;
+        out.reserve((bytes.size() + 2) / 3 * 4);
+        for (size_t pos = 0; pos < bytes.size(); pos += 3) {
+            size_t remaining = bytes.size() - pos;
+            unsigned int b0 = static_cast<unsigned char>(bytes[pos]);
+            unsigned int b1 = remaining > 1 ? static_cast<unsigned char>(bytes[pos + 1]) : 0;
+            unsigned int b2 = remaining > 2 ? static_cast<unsigned char>(bytes[pos + 2]) : 0;
+            unsigned int triple = (b0 << 16) | (b1 << 8) | b2;
+
+            out.push_back(chars[(triple >> 18) & 0x3f]);
+            out.push_back(chars[(triple >> 12) & 0x3f]);
+            out.push_back(remaining > 1 ? chars[(triple >> 6) & 0x3f] : trailing);
+            out.push_back(remaining > 2 ? chars[triple & 0x3f] : trailing);
+        }
+        return out;
+    }
+
+    struct Outcome {
+        bool threw = false;
+        std::string bytes;
+    };
+
+    template <typename Fn>
+    Outcome run(Fn&& fn) {
+        Outcome outcome;
+        try {
+            outcome.bytes = fn();
+        } catch (const std::runtime_error&) {
+            outcome.threw = true;
+        }
+        return outcome;
+    }
+
+    size_t failures = 0;
+    size_t checks = 0;
+
+    /**
+     * @brief 以参照解码器的结果（含是否抛异常）校验各个向量化入口
+     */
+    void crossCheck(const std::string& encoded, const char* what) {
+        ++checks;
+        Outcome expected = run([&] { return scalarDecode(encoded); });
+
+        Outcome viaString = run([&] { return base64_decode(encoded); });
+        Outcome viaBuffer = run([&] {
+            std::vector<unsigned char> buffer;
+            size_t n = base64_decode_into(std::string_view(encoded), buffer);
+            return std::string(reinterpret_cast<const char*>(buffer.data()), n);
+        });
+
+        for (const Outcome* actual : {&viaString, &viaBuffer}) {
+            if (actual->threw != expected.threw || (!expected.threw && actual->bytes != expected.bytes)) {
+                if (++failures <= 10) {
+                    std::printf("MISMATCH (%s) length=%zu expected %s, got %s\n", what, encoded.size(),
+                                expected.threw ? "exception" : "bytes", actual->threw ? "exception" : "bytes");
+                }
+                return;
+            }
+        }
+
+        // 向量化块解码：只处理完整的标准字母表块，结果须与参照解码器对已处理前缀的解码一致
+        std::vector<unsigned char> blocks(base64_decoded_max_size(encoded.size()) + 1);
+        size_t consumed = 0;
+        size_t written = base64_simd::decode(encoded.data(), encoded.size(), blocks.data(), consumed);
+        std::string prefix = scalarDecode(std::string_view(encoded).substr(0, consumed));
+        if (consumed % 4 != 0 || consumed > encoded.size() || written != prefix.size() ||
+            prefix.compare(0, written, reinterpret_cast<const char*>(blocks.data()), written) != 0) {
+            if (++failures <= 10) {
+                std::printf("MISMATCH (%s, simd blocks) length=%zu consumed=%zu written=%zu\n", what,
+                            encoded.size(), consumed, written);
+            }
+        }
+    }
+
+    /**
+     * @brief 以参照编码器校验 base64_encode，并确认参照解码器能还原原始字节
+     */
+    bool checkEncode(const std::string& bytes, bool url) {
+        ++checks;
+        std::string expected = scalarEncode(bytes, url);
+        std::string actual = base64_encode(bytes, url);
+        if (actual != expected || scalarDecode(actual) != bytes) {
+            if (++failures <= 10) {
+                std::printf("MISMATCH (encode %s) length=%zu\n", url ? "url" : "standard", bytes.size());
+            }
+            return false;
+        }
+        return true;
+    }
+
+    std::string randomBytes(std::mt19937& rng, size_t length) {
+        std::string bytes(length, '\0');
+        for (auto& c : bytes) {
+            c = static_cast<char>(rng() & 0xFF);
+        }
+        return bytes;
+    }
+
+    void validate() {
+        std::mt19937 rng(20261016);
+
+        for (size_t length = 0; length <= 3000; ++length) {
+            std::string bytes = randomBytes(rng, length);
+
+            for (bool url : {false, true}) {
+                checkEncode(bytes, url);
+                std::string encoded = base64_encode(bytes, url);
+                crossCheck(encoded, url ? "url" : "standard");
+
+                // 去掉填充（RFC 2045 允许），以及把填充换成另一种字符
+                std::string unpadded = encoded;
+                while (!unpadded.empty() && (unpadded.back() == '=' || unpadded.back() == '.')) {
+                    unpadded.pop_back();
+                }
+                crossCheck(unpadded, "unpadded");
+
+                std::string swapped = encoded;
+                for (auto& c : swapped) {
+                    if (c == '=') c = '.';
+                    else if (c == '.') c = '=';
+                }
+                crossCheck(swapped, "swapped padding");
+            }
+        }
+
+        // 编码器每轮消耗24字节（AVX2，其后接 SSE 尾部）或48字节（NEON），在各块边界前后
+        // 取覆盖 0~3 mod 3 的长度（±4 同时覆盖 AVX2 的28字节读取门限），检查块循环与标量尾部的衔接
+        for (size_t block : {24, 48}) {
+            for (size_t k = 1; k <= 8; ++k) {
+                for (size_t length = k * block - 4; length <= k * block + 4; ++length) {
+                    std::string bytes = randomBytes(rng, length);
+                    for (bool url : {false, true}) {
+                        checkEncode(bytes, url);
+                    }
+                }
+            }
+        }
+
+        // 损坏的输入：随机位置替换为非法字符、填充字符或另一字母表字符
+        const char replacements[] = {'!', '*', ' ', '\n', '=', '.', '-', '_', '+', '/', '\0', '\x80'};
+        for (int i = 0; i < 20000; ++i) {
+            std::string encoded = base64_encode(randomBytes(rng, rng() % 2048 + 1), (i & 1) != 0);
+            size_t edits = rng() % 3 + 1;
+            for (size_t e = 0; e < edits; ++e) {
+                encoded[rng() % encoded.size()] = replacements[rng() % sizeof(replacements)];
+            }
+            crossCheck(encoded, "corrupted");
+        }
+
+        // 截断到非4的倍数
+        for (int i = 0; i < 2000; ++i) {
+            std::string encoded = base64_encode(randomBytes(rng, rng() % 512 + 1));
+            encoded.resize(rng() % encoded.size());
+            crossCheck(encoded, "truncated");
+        }
+    }
+
+    template <typename Fn>
+    double throughputMBps(size_t bytes, int iterations, Fn&& fn) {
+        fn();   // 预热
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            fn();
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return static_cast<double>(bytes) * iterations / seconds / 1e6;
+    }
+
+    void benchmark(size_t payloadBytes, int iterations) {
+        std::mt19937 rng(42);
+        std::string encoded = base64_encode(randomBytes(rng, payloadBytes));
+        std::vector<unsigned char> buffer;
+        volatile size_t sink = 0;
+
+        double scalar = throughputMBps(encoded.size(), iterations, [&] {
+            sink = sink + scalarDecode(encoded).size();
+        });
+        double decodeString = throughputMBps(encoded.size(), iterations, [&] {
+            sink = sink + base64_decode(encoded).size();
+        });
+        double decodeInto = throughputMBps(encoded.size(), iterations, [&] {
+            sink = sink + base64_decode_into(std::string_view(encoded), buffer);
+        });
+
+        std::printf("decode %zu KiB payload (%zu base64 chars), %d iterations, MB/s of input:\n",
+                    payloadBytes / 1024, encoded.size(), iterations);
+        std::printf("  scalar reference    %10.1f\n", scalar);
+        std::printf("  base64_decode       %10.1f  (%.1fx)\n", decodeString, decodeString / scalar);
+        std::printf("  base64_decode_into  %10.1f  (%.1fx)\n", decodeInto, decodeInto / scalar);
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::printf("base64 codec: %s\n", base64_simd::implementationName());
+
+    validate();
+    std::printf("validation: %zu inputs cross-checked (encode + decode), %zu mismatches\n", checks, failures);
+
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 20;
+    benchmark(64 * 1024, iterations * 50);
+    benchmark(6 * 1024 * 1024, iterations);
+
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
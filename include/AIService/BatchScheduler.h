@@ -0,0 +1,119 @@
+//
+// Created by YJK on 2026/10/16.
+//
+
+#ifndef BATCH_SCHEDULER_H
+#define BATCH_SCHEDULER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "AIService/ModelPool.h"
+
+/**
+ * @brief 动态批处理调度器
+ * 每个模型类型一个实例：收集并发请求，达到最大批大小或最长等待时间后
+ * 占用一个模型实例执行一次批量推理，再把结果分发给各个等待的请求
+ */
+class BatchScheduler {
+public:
+    /**
+     * @brief 构造函数
+     * @param pool 对应的模型池
+     * @param maxBatchSize 最大批大小
+     * @param maxWaitMs 凑批的最长等待时间（毫秒）
+     * @param maxQueue 排队请求数上限，超出时提交立即失败（0 表示不限制）
+     */
+    BatchScheduler(ModelPool& pool, size_t maxBatchSize, int maxWaitMs, size_t maxQueue = 0);
+
+    ~BatchScheduler();
+
+    // 禁止拷贝
+    BatchScheduler(const BatchScheduler&) = delete;
+    BatchScheduler& operator=(const BatchScheduler&) = delete;
+
+    /**
+     * @brief 启动调度线程（线程数与模型实例数一致，使多个批次可以并行执行）
+     * @param workerCount 调度线程数
+     * @param cpuAffinity 调度线程绑定的CPU核心（为空时不绑定）
+     */
+    void start(size_t workerCount, const std::vector<int>& cpuAffinity = {});
+
+    /**
+     * @brief 停止调度，未处理的请求全部以失败返回
+     */
+    void stop();
+
+    /**
+     * @brief 提交一次推理并阻塞等待结果
+     * @param image 输入图像
+     * @param params 推理参数
+     * @param output 推理结果
+     * @param timeoutMs 获取模型实例的超时时间（毫秒）
+     * @param priority 调度属性（批次以其中最高优先级和最早截止时间参与实例调度）
+     * @param timings 可选，写入凑批与等待实例（POOL_WAIT）、批量推理（INFERENCE）的耗时
+     * @return 推理是否成功
+     */
+    bool submit(const cv::Mat& image, const InferenceParams& params, InferenceOutput& output, int timeoutMs,
+                const AcquirePriority& priority = AcquirePriority(), StageTimings* timings = nullptr);
+
+    /**
+     * @brief 批处理统计信息
+     */
+    struct Stats {
+        size_t queuedRequests;
+        size_t totalBatches;
+        size_t totalBatchedRequests;
+        double averageBatchSize;
+        size_t maxBatchSize;
+        int maxWaitMs;
+        size_t maxQueue;
+        size_t rejectedRequests;
+    };
+
+    Stats getStats() const;
+
+private:
+    struct BatchItem {
+        cv::Mat image;
+        InferenceParams params;
+        InferenceOutput output;
+        int priority = 0;
+        std::chrono::steady_clock::time_point enqueueTime;
+        std::chrono::steady_clock::time_point deadline;
+        std::chrono::steady_clock::time_point inferenceStart;
+        std::chrono::steady_clock::time_point inferenceEnd;
+        std::promise<bool> done;
+    };
+
+    // 调度线程主循环
+    void workerLoop();
+
+    // 执行一个批次
+    void runBatch(std::vector<std::shared_ptr<BatchItem>>& batch);
+
+    ModelPool& pool_;
+    size_t maxBatchSize_;
+    std::chrono::milliseconds maxWait_;
+    size_t maxQueue_;
+
+    mutable std::mutex queueMutex_;
+    std::condition_variable queueCondition_;
+    std::deque<std::shared_ptr<BatchItem>> queue_;
+
+    std::vector<std::thread> workers_;
+    std::atomic<bool> running_{false};
+
+    // 统计信息
+    std::atomic<size_t> totalBatches_{0};
+    std::atomic<size_t> totalBatchedRequests_{0};
+    std::atomic<size_t> rejectedRequests_{0};
+};
+
+#endif // BATCH_SCHEDULER_H
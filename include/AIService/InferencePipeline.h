@@ -0,0 +1,172 @@
+//
+// Created by YJK on 2026/10/16.
+//
+
+#ifndef INFERENCE_PIPELINE_H
+#define INFERENCE_PIPELINE_H
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "AIService/ModelPool.h"
+#include "common/BoundedQueue.h"
+#include "common/FramePool.h"
+
+/**
+ * @brief 分阶段推理流水线
+ * 解码线程池 → 按模型类型划分的推理工作线程 → 序列化线程池，阶段之间以有界队列相连；
+ * 请求 N+1 的解码与请求 N 的推理重叠进行，下游队列满时上游阻塞，入口队列满时立即拒绝
+ */
+class InferencePipeline {
+public:
+    /**
+     * @brief 流水线执行结果
+     */
+    enum class Result {
+        OK,
+        REJECTED,           // 解码队列已满
+        DECODE_FAILED,      // 图像解码失败
+        EXPIRED,            // 排队期间已超过截止时间
+        INFERENCE_FAILED,   // 模型不存在、获取实例超时或推理失败
+        SERIALIZE_FAILED,   // 序列化回调抛出异常
+        SHUTDOWN            // 流水线已停止
+    };
+
+    /**
+     * @brief 一次请求
+     * 调用方在 execute() 返回前保证 data、frame、output 以及 serialize 引用的对象有效
+     */
+    struct Job {
+        const unsigned char* data = nullptr;    // 编码后的图像数据
+        size_t size = 0;
+        int modelType = 0;
+        cv::Size inputSize;                     // 模型输入尺寸，用于降采样解码
+        InferenceParams params;
+        int timeoutMs = 0;                      // 获取模型实例的超时时间，再以截止时间为上限
+        AcquirePriority priority;
+        StageTimings* timings = nullptr;
+        FramePool::Frame* frame = nullptr;      // 解码结果
+        InferenceOutput* output = nullptr;      // 推理结果（降采样解码时检测框已换算回原图）
+        std::function<void()> serialize;        // 推理成功后在序列化线程中执行，可为空
+    };
+
+    /**
+     * @brief 推理回调：参数为 (模型类型, 图像, 推理参数, 超时, 调度属性, 阶段耗时, 结果)
+     */
+    using InferFunction = std::function<bool(int, const cv::Mat&, const InferenceParams&, int,
+                                             const AcquirePriority&, StageTimings*, InferenceOutput&)>;
+
+    struct Options {
+        size_t decodeThreads = 2;
+        size_t serializeThreads = 2;
+        size_t queueDepth = 64;                 // 每个阶段的队列容量
+    };
+
+    /**
+     * @brief 单个阶段的统计
+     */
+    struct StageStats {
+        std::string stage;          // decode / inference / serialize
+        int modelType = -1;         // 推理阶段按模型类型区分，其余为 -1
+        size_t queued = 0;
+        size_t capacity = 0;
+        size_t threads = 0;
+        uint64_t processed = 0;
+    };
+
+    struct Stats {
+        bool running = false;
+        uint64_t submitted = 0;
+        uint64_t rejected = 0;
+        uint64_t completed = 0;
+        uint64_t failed = 0;
+        std::vector<StageStats> stages;
+    };
+
+    InferencePipeline(const Options& options, InferFunction infer);
+
+    ~InferencePipeline();
+
+    // 禁止拷贝
+    InferencePipeline(const InferencePipeline&) = delete;
+    InferencePipeline& operator=(const InferencePipeline&) = delete;
+
+    /**
+     * @brief 注册模型的推理阶段（须在 start() 之前调用）
+     * @param modelType 模型类型
+     * @param workerCount 推理工作线程数
+     * @param cpuAffinity 推理工作线程绑定的CPU核心（为空时不绑定）
+     */
+    void addModel(int modelType, size_t workerCount, const std::vector<int>& cpuAffinity = {});
+
+    /**
+     * @brief 启动各阶段线程
+     */
+    void start();
+
+    /**
+     * @brief 停止接收新请求，处理完已入队的请求后按阶段顺序退出
+     */
+    void stop();
+
+    /**
+     * @brief 提交请求并阻塞等待其经过全部阶段
+     */
+    Result execute(Job& job);
+
+    Stats getStats() const;
+
+    static const char* resultToString(Result result);
+
+private:
+    // 调用方栈上的完成通知
+    struct Ticket {
+        Job* job = nullptr;
+        Result result = Result::OK;
+        bool done = false;
+        std::mutex mutex;
+        std::condition_variable condition;
+    };
+
+    struct ModelStage {
+        int modelType;
+        size_t workerCount;
+        std::vector<int> cpuAffinity;
+        BoundedQueue<Ticket*> queue;
+        std::vector<std::thread> workers;
+        std::atomic<uint64_t> processed{0};
+
+        ModelStage(int type, size_t workers, std::vector<int> cpus, size_t depth)
+                : modelType(type), workerCount(workers), cpuAffinity(std::move(cpus)), queue(depth) {}
+    };
+
+    void decodeLoop();
+    void inferenceLoop(ModelStage& stage);
+    void serializeLoop();
+
+    void complete(Ticket* ticket, Result result);
+
+    Options options_;
+    InferFunction infer_;
+
+    BoundedQueue<Ticket*> decodeQueue_;
+    BoundedQueue<Ticket*> serializeQueue_;
+    std::unordered_map<int, std::unique_ptr<ModelStage>> models_;   // start() 之后只读
+
+    std::vector<std::thread> decodeWorkers_;
+    std::vector<std::thread> serializeWorkers_;
+    std::atomic<bool> running_{false};
+
+    std::atomic<uint64_t> submitted_{0};
+    std::atomic<uint64_t> rejected_{0};
+    std::atomic<uint64_t> completed_{0};
+    std::atomic<uint64_t> failed_{0};
+    std::atomic<uint64_t> decoded_{0};
+    std::atomic<uint64_t> serialized_{0};
+};
+
+#endif // INFERENCE_PIPELINE_H
@@ -5,25 +5,76 @@
 #ifndef MODEL_POOL_H
 #define MODEL_POOL_H
 
-#include <queue>
 #include <mutex>
 #include <condition_variable>
 #include <memory>
 #include <chrono>
+#include <array>
 #include <atomic>
-#include <set>
 #include <unordered_map>
-#include "AIService/rknn/rknnPool.h"
+#include <set>
+#include <thread>
+#include <vector>
+#include "AIService/engine/InferenceEngine.h"
+#include "common/LatencyHistogram.h"
+#include "common/LockFreeQueue.h"
 #include "common/Logger.h"
 
+/**
+ * @brief 模型池等待策略配置
+ */
+struct PoolOptions {
+    // 进入休眠等待前的自旋次数
+    int spinIterations = 100;
+
+    // 优先复用当前线程上次使用的实例（缓存亲和）
+    bool threadAffinity = true;
+
+    // 休眠等待者上限，超出时获取立即失败（0 表示不限制）
+    size_t maxWaiters = 0;
+
+    // 弹性伸缩：实例数在 [minInstances, maxInstances] 之间按排队情况调整，
+    // maxInstances 不大于初始实例数时不启用；minInstances 为0时取初始实例数
+    size_t minInstances = 0;
+    size_t maxInstances = 0;
+
+    // 一个评估周期内获取等待时间的p95超过该值时增加一个实例（毫秒）
+    int scaleUpWaitMs = 20;
+
+    // 连续该时长内同时占用的实例数始终小于实例总数时回收一个空闲实例（毫秒）
+    int scaleDownIdleMs = 60000;
+
+    // 伸缩与内存回收的评估周期（毫秒）
+    int scaleIntervalMs = 1000;
+
+    // 实例空闲超过该时长后回收其工作集内存（毫秒，0 表示不回收，工作集始终保持在历史最高容量）
+    int trimIdleMs = 0;
+};
+
+/**
+ * @brief 获取实例时的调度属性
+ * 等待队列按 优先级（高者先）-> 截止时间（早者先）-> 到达顺序 排序
+ */
+struct AcquirePriority {
+    // 优先级，数值越大越优先（告警类摄像头可设为正数，批量重处理任务可设为负数）
+    int priority = 0;
+
+    // 请求截止时间，未设置时以获取超时时间作为截止时间
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+};
+
 /**
  * @brief 线程安全的模型池
- * 维护多个相同类型的模型实例，支持并发访问
+ * 维护多个相同类型的模型实例，支持并发访问。
+ * 空闲实例序号保存在无锁环形队列中，获取时先自旋再休眠等待；
+ * 休眠等待者按优先级和截止时间排队（EDF），归还的实例直接交给队首等待者。
+ * 启用弹性伸缩时槽位按最大实例数预留，由后台线程按获取等待时间创建或回收实例
  */
 class ModelPool {
 public:
-    explicit ModelPool(size_t poolSize = 3)
-            : maxPoolSize_(poolSize), shutdown_(false), enabled_(false) {}
+    explicit ModelPool(size_t poolSize = 3, const PoolOptions& options = PoolOptions())
+            : poolSize_(poolSize), options_(options), shutdown_(false), enabled_(false),
+              poolId_(nextPoolId_.fetch_add(1)) {}
 
     ~ModelPool() {
         shutdown();
@@ -31,25 +82,62 @@ public:
 
     /**
      * @brief 初始化模型池
-     * @param modelPath 模型文件路径
-     * @param modelType 模型类型
-     * @param threshold 检测阈值
+     * @param info 推理引擎创建参数（后端、模型路径、模型类型、阈值等）
      * @return 初始化是否成功
      */
-    bool initialize(const std::string& modelPath, int modelType, float threshold);
+    bool initialize(const EngineCreateInfo& info);
 
     /**
      * @brief 获取一个可用的模型实例
      * @param timeout 超时时间（毫秒）
      * @return 模型实例的智能指针，如果超时返回nullptr
      */
-    std::shared_ptr<rknn_lite> acquireModel(int timeoutMs = 5000);
+    std::shared_ptr<InferenceEngine> acquireModel(int timeoutMs = 5000);
 
     /**
      * @brief 归还模型实例到池中
      * @param model 模型实例
      */
-    void releaseModel(std::shared_ptr<rknn_lite> model);
+    void releaseModel(std::shared_ptr<InferenceEngine> model);
+
+    /**
+     * @brief 按序号获取实例（供ModelAcquirer使用，避免指针查找）
+     * @param timeoutMs 超时时间（毫秒）
+     * @param priority 调度属性（优先级、截止时间）
+     * @return 实例序号，超时或池不可用时返回-1
+     */
+    int acquireSlot(int timeoutMs = 5000, const AcquirePriority& priority = AcquirePriority());
+
+    /**
+     * @brief 按序号归还实例
+     * @param index 实例序号
+     */
+    void releaseSlot(int index);
+
+    /**
+     * @brief 获取指定序号的实例
+     */
+    std::shared_ptr<InferenceEngine> getSlotEngine(int index) const;
+
+    /**
+     * @brief 槽位数（弹性伸缩时为最大实例数），初始化后不变
+     */
+    size_t getCapacity() const { return slotCount_; }
+
+    /**
+     * @brief 是否启用弹性伸缩
+     */
+    bool isElastic() const { return elastic_; }
+
+    /**
+     * @brief 单个实例的累计统计
+     */
+    struct InstanceStatus {
+        size_t index;
+        bool busy;
+        uint64_t acquireCount;      // 累计被获取次数（含直接交接）
+        double busyTimeSeconds;     // 累计占用时间（含当前进行中的占用）
+    };
 
     /**
      * @brief 获取池的状态信息
@@ -60,8 +148,32 @@ public:
         size_t busyModels;
         bool isEnabled;
         std::string modelPath;
+        std::string backend;
         int modelType;
         float threshold;
+        size_t totalAcquires;   // 累计获取次数
+        size_t totalReleases;   // 累计归还次数
+        size_t timeoutCount;    // 获取超时次数
+        size_t rejectedCount = 0;   // 等待者已满而立即失败的次数
+        size_t maxWaiters = 0;      // 等待者上限（0 表示不限制）
+        size_t waitingRequests = 0; // 当前休眠等待者数
+
+        // 时间加权统计（自初始化起累计）
+        double uptimeSeconds = 0.0;                 // 池初始化至今的时间
+        double busyTimeSeconds = 0.0;               // 所有实例累计占用时间
+        double utilization = 0.0;                   // busyTimeSeconds / (uptimeSeconds * totalModels)
+        double totalWaitSeconds = 0.0;              // 成功获取前的累计等待时间
+        LatencyHistogram::Snapshot acquireWait;     // 成功获取的等待时间分布
+        std::vector<InstanceStatus> instances;
+
+        // 弹性伸缩（未启用时上下限均为初始实例数）
+        bool elastic = false;
+        size_t minInstances = 0;
+        size_t maxInstances = 0;
+        uint64_t scaleUps = 0;
+        uint64_t scaleDowns = 0;
+
+        uint64_t trimCount = 0;     // 空闲实例回收工作集内存的次数
     };
 
     PoolStatus getStatus() const;
@@ -77,6 +189,11 @@ public:
      */
     int getModelType() const { return modelType_; }
 
+    /**
+     * @brief 引擎报告的模型输入尺寸（未知时为空），初始化后不变
+     */
+    cv::Size getInputSize() const { return inputSize_; }
+
     /**
      * @brief 关闭模型池
      */
@@ -85,27 +202,162 @@ public:
     /*
      * @brief 模型资源清理
      * */
-    void clearModelResources(std::shared_ptr<rknn_lite> model);
+    void clearModelResources(std::shared_ptr<InferenceEngine> model);
 
 private:
+    enum SlotState : int {
+        SLOT_FREE = 0,
+        SLOT_BUSY = 1,
+        SLOT_EMPTY = 2      // 弹性伸缩预留的槽位，尚未创建实例或实例已回收
+    };
+
+    /**
+     * @brief 实例槽位
+     * inRing 保证每个序号在空闲队列中最多出现一次；
+     * 通过线程亲和直接占用的槽位会在队列中留下过期序号，出队时用 state 的CAS过滤。
+     * engine 只在槽位处于 SLOT_EMPTY 时由伸缩线程修改，之后以 state 的发布/获取保证可见
+     */
+    struct InstanceSlot {
+        std::shared_ptr<InferenceEngine> engine;
+        std::atomic<const InferenceEngine*> engineKey{nullptr};   // 供 releaseModel 按指针查找
+        std::atomic<int> state{SLOT_FREE};
+        std::atomic<bool> inRing{false};
+
+        // 占用统计：busySinceNs 为本次占用开始时间（steady_clock 纳秒），
+        // 交接给等待者时实例保持占用，占用区间延续到真正回到空闲状态
+        std::atomic<int64_t> busySinceNs{0};
+        std::atomic<uint64_t> busyNanos{0};
+        std::atomic<uint64_t> acquireCount{0};
+        std::atomic<int64_t> lastReleaseNs{0};
+        int64_t trimmedAtNs = 0;    // 上次回收工作集的时间，仅后台线程访问
+
+        // 实例存活时间（用于弹性伸缩下的时间加权利用率）
+        std::atomic<int64_t> activeSinceNs{0};
+        std::atomic<uint64_t> activeNanos{0};
+    };
+
+    /**
+     * @brief 休眠等待者
+     * 位于等待线程的栈上，由 parkMutex_ 保护；grantedIndex >= 0 表示已被直接分配实例
+     */
+    struct Waiter {
+        int priority;
+        std::chrono::steady_clock::time_point deadline;
+        uint64_t sequence;
+        int grantedIndex = -1;
+        std::condition_variable condition;
+    };
+
+    struct WaiterOrder {
+        bool operator()(const Waiter* a, const Waiter* b) const {
+            if (a->priority != b->priority) {
+                return a->priority > b->priority;
+            }
+            if (a->deadline != b->deadline) {
+                return a->deadline < b->deadline;
+            }
+            return a->sequence < b->sequence;
+        }
+    };
+
+    // 尝试立即获取空闲实例（无阻塞）
+    bool tryAcquireSlot(size_t& index);
+
+    // 占用指定槽位
+    bool claimSlot(size_t index);
+
+    // 槽位回到空闲状态，并累计本次占用时间
+    void markSlotFree(size_t index);
+
+    // 交给队首等待者或放回空闲队列（槽位需处于占用状态）
+    void returnSlot(size_t index);
+
+    // 后台维护线程：弹性伸缩与空闲实例的内存回收
+    void maintenanceLoop();
+    void trimIdleInstances();
+
+    // 弹性伸缩：评估、创建一个实例、回收一个空闲实例
+    void evaluateScaling();
+    bool growInstance();
+    bool retireInstance();
+    std::shared_ptr<InferenceEngine> createEngine(size_t index) const;
+
+    // 记录一次成功获取的等待时间
+    void recordAcquire(size_t index, std::chrono::steady_clock::time_point acquireStart);
+
+    static int64_t steadyNanos() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // 线程亲和：当前线程上次使用的实例序号
+    bool getAffinitySlot(size_t& index) const;
+    void setAffinitySlot(size_t index) const;
+
+    // 控制路径（初始化、关闭）使用的互斥锁
     mutable std::mutex poolMutex_;
-    std::condition_variable condition_;
-    std::queue<std::shared_ptr<rknn_lite>> availableModels_;
-    std::set<std::shared_ptr<rknn_lite>> allModels_;
 
-    size_t maxPoolSize_;
+    // 实例槽位（槽位数组初始化后不再变化，弹性伸缩只改变槽位中的实例）
+    std::unique_ptr<InstanceSlot[]> slots_;
+    size_t slotCount_ = 0;
+
+    // 空闲实例序号队列
+    BoundedMpmcQueue<size_t> freeSlots_;
+
+    // 将空闲实例直接交给队首等待者（需持有 parkMutex_）
+    bool handOffToWaiter(size_t index);
+
+    // 唤醒所有等待者（需持有 parkMutex_）
+    void notifyAllWaiters();
+
+    // 休眠等待队列（仅在自旋失败后使用）
+    std::mutex parkMutex_;
+    std::set<Waiter*, WaiterOrder> waiters_;
+    uint64_t nextWaiterSequence_ = 0;
+    std::atomic<int> parkedWaiters_{0};
+
+    size_t poolSize_;
+    PoolOptions options_;
     std::atomic<bool> enabled_;
     std::atomic<bool> shutdown_;
 
-    // 模型配置信息
+    // 池的唯一标识（用于线程亲和记录）
+    const uint64_t poolId_;
+    static std::atomic<uint64_t> nextPoolId_;
+
+    // 模型配置信息（createInfo_ 供伸缩时创建实例）
+    EngineCreateInfo createInfo_;
+    cv::Size inputSize_;
     std::string modelPath_;
-    int modelType_;
-    float threshold_;
+    std::string backend_;
+    int modelType_ = 0;
+    float threshold_ = 0.0f;
 
     // 统计信息
     mutable std::atomic<size_t> totalAcquires_{0};
     mutable std::atomic<size_t> totalReleases_{0};
     mutable std::atomic<size_t> timeoutCount_{0};
+    std::atomic<size_t> rejectedCount_{0};
+
+    // 获取等待时间分布（仅统计成功获取）与初始化时间
+    LatencyHistogram acquireWait_;
+    std::chrono::steady_clock::time_point createdAt_;
+
+    // 弹性伸缩状态
+    bool elastic_ = false;
+    size_t minInstances_ = 0;
+    size_t maxInstances_ = 0;
+    std::atomic<size_t> activeInstances_{0};
+    std::atomic<int> busyInstances_{0};
+    std::atomic<int> peakBusy_{0};              // 当前回收观察期内同时占用实例数的峰值
+    LatencyHistogram recentWait_;               // 当前评估周期内的获取等待（含超时）
+    std::atomic<uint64_t> scaleUps_{0};
+    std::atomic<uint64_t> scaleDowns_{0};
+    int64_t lastScaleNs_ = 0;                   // 仅后台线程访问
+    std::atomic<uint64_t> trimCount_{0};
+    std::thread maintenanceThread_;
+    std::mutex maintenanceMutex_;
+    std::condition_variable maintenanceCondition_;
 };
 
 /**
@@ -114,13 +366,17 @@ private:
  */
 class ModelAcquirer {
 public:
-    ModelAcquirer(ModelPool& pool, int timeoutMs = 5000)
-            : pool_(pool), model_(pool.acquireModel(timeoutMs)) {}
+    ModelAcquirer(ModelPool& pool, int timeoutMs = 5000, const AcquirePriority& priority = AcquirePriority())
+            : pool_(pool), index_(pool.acquireSlot(timeoutMs, priority)) {
+        if (index_ >= 0) {
+            model_ = pool_.getSlotEngine(index_);
+        }
+    }
 
     ~ModelAcquirer() {
-        if (model_) {
+        if (index_ >= 0) {
             pool_.clearModelResources(model_);
-            pool_.releaseModel(model_);
+            pool_.releaseSlot(index_);
         }
     }
 
@@ -130,25 +386,44 @@ public:
 
     // 支持移动
     ModelAcquirer(ModelAcquirer&& other) noexcept
-            : pool_(other.pool_), model_(std::move(other.model_)) {}
+            : pool_(other.pool_), index_(other.index_), model_(std::move(other.model_)) {
+        other.index_ = -1;
+    }
 
-    rknn_lite* get() const { return model_.get(); }
-    rknn_lite* operator->() const { return model_.get(); }
-    rknn_lite& operator*() const { return *model_; }
+    InferenceEngine* get() const { return model_.get(); }
+    InferenceEngine* operator->() const { return model_.get(); }
+    InferenceEngine& operator*() const { return *model_; }
 
     bool isValid() const { return model_ != nullptr; }
 
 private:
     ModelPool& pool_;
-    std::shared_ptr<rknn_lite> model_;
+    int index_;
+    std::shared_ptr<InferenceEngine> model_;
 };
 
 /**
  * @brief 并发监控器
- * 统计并发请求信息
+ * 统计并发请求信息，以及各处理阶段的延迟分布（总体与按模型类型）
  */
 class ConcurrencyMonitor {
 public:
+    // 按模型类型单独统计的类型上限，超出的类型只计入总体
+    static constexpr int MAX_MODEL_TYPES = 32;
+    static constexpr size_t STAGE_COUNT = static_cast<size_t>(LatencyStage::COUNT);
+
+    ConcurrencyMonitor() = default;
+
+    ~ConcurrencyMonitor() {
+        for (auto& histograms : byModelType_) {
+            delete histograms.load();
+        }
+    }
+
+    // 禁止拷贝
+    ConcurrencyMonitor(const ConcurrencyMonitor&) = delete;
+    ConcurrencyMonitor& operator=(const ConcurrencyMonitor&) = delete;
+
     void requestStarted() {
         activeRequests_++;
         totalRequests_++;
@@ -162,6 +437,25 @@ public:
         failedRequests_++;
     }
 
+    /**
+     * @brief 记录一个请求各阶段的耗时
+     * @param modelType 模型类型
+     * @param timings 各阶段耗时，未经过的阶段（-1）不记录
+     */
+    void recordLatency(int modelType, const StageTimings& timings) {
+        StageHistograms* perModel = modelHistograms(modelType);
+        for (size_t i = 0; i < STAGE_COUNT; ++i) {
+            int64_t micros = timings.micros[i];
+            if (micros < 0) {
+                continue;
+            }
+            overall_.stages[i].record(static_cast<uint64_t>(micros));
+            if (perModel) {
+                perModel->stages[i].record(static_cast<uint64_t>(micros));
+            }
+        }
+    }
+
     struct Stats {
         int active;
         int total;
@@ -169,6 +463,15 @@ public:
         double failureRate;
     };
 
+    /**
+     * @brief 单个阶段的延迟统计
+     */
+    struct LatencyStats {
+        LatencyStage stage;
+        int modelType;                       // -1 表示所有模型类型
+        LatencyHistogram::Snapshot snapshot;
+    };
+
     Stats getStats() const {
         int total = totalRequests_.load();
         int failed = failedRequests_.load();
@@ -180,16 +483,83 @@ public:
         };
     }
 
+    /**
+     * @brief 获取有记录的阶段延迟统计：先是总体，再按模型类型升序
+     */
+    std::vector<LatencyStats> getLatencyStats() const {
+        std::vector<LatencyStats> result;
+        appendLatencyStats(overall_, -1, result);
+        for (int type = 0; type < MAX_MODEL_TYPES; ++type) {
+            const StageHistograms* perModel = byModelType_[type].load(std::memory_order_acquire);
+            if (perModel) {
+                appendLatencyStats(*perModel, type, result);
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief 访问某阶段的总体直方图（用于按桶导出）
+     */
+    const LatencyHistogram& stageHistogram(LatencyStage stage) const {
+        return overall_.stages[static_cast<size_t>(stage)];
+    }
+
     void reset() {
         activeRequests_.store(0);
         totalRequests_.store(0);
         failedRequests_.store(0);
+        for (auto& histogram : overall_.stages) {
+            histogram.reset();
+        }
+        for (auto& histograms : byModelType_) {
+            if (StageHistograms* perModel = histograms.load()) {
+                for (auto& histogram : perModel->stages) {
+                    histogram.reset();
+                }
+            }
+        }
     }
 
 private:
+    struct StageHistograms {
+        std::array<LatencyHistogram, STAGE_COUNT> stages;
+    };
+
+    // 首次记录某模型类型时创建其直方图组，并发创建时只保留一个
+    StageHistograms* modelHistograms(int modelType) {
+        if (modelType < 0 || modelType >= MAX_MODEL_TYPES) {
+            return nullptr;
+        }
+        auto& slot = byModelType_[modelType];
+        StageHistograms* perModel = slot.load(std::memory_order_acquire);
+        if (perModel) {
+            return perModel;
+        }
+        auto* created = new StageHistograms();
+        if (slot.compare_exchange_strong(perModel, created, std::memory_order_acq_rel)) {
+            return created;
+        }
+        delete created;
+        return perModel;
+    }
+
+    static void appendLatencyStats(const StageHistograms& histograms, int modelType,
+                                   std::vector<LatencyStats>& result) {
+        for (size_t i = 0; i < STAGE_COUNT; ++i) {
+            if (histograms.stages[i].count() == 0) {
+                continue;
+            }
+            result.push_back({static_cast<LatencyStage>(i), modelType, histograms.stages[i].snapshot()});
+        }
+    }
+
     std::atomic<int> activeRequests_{0};
     std::atomic<int> totalRequests_{0};
     std::atomic<int> failedRequests_{0};
+
+    StageHistograms overall_;
+    std::array<std::atomic<StageHistograms*>, MAX_MODEL_TYPES> byModelType_{};
 };
 
 #endif // MODEL_POOL_H
@@ -0,0 +1,51 @@
+//
+// Created by YJK on 2026/10/16.
+//
+
+#ifndef CPU_REFERENCE_ENGINE_H
+#define CPU_REFERENCE_ENGINE_H
+
+#include <cstdint>
+#include "AIService/engine/InferenceEngine.h"
+
+/**
+ * @brief CPU参考推理引擎
+ * 不依赖NPU，按配置的耗时和检测数量生成确定性结果（相同输入得到相同输出），
+ * 用于在x86主机上运行、压测和分析NPU层以上的完整链路
+ */
+class CpuReferenceEngine : public InferenceEngine {
+public:
+    explicit CpuReferenceEngine(const EngineCreateInfo& info);
+
+    bool infer(const cv::Mat& image, const InferenceParams& params, InferenceOutput& output) override;
+
+    // 整批只模拟一次推理耗时，近似多batch模型在NPU上的表现
+    void inferBatch(const std::vector<cv::Mat>& images,
+                    const std::vector<InferenceParams>& params,
+                    std::vector<InferenceOutput>& outputs,
+                    std::vector<char>& success) override;
+
+    void releaseResources() override {}
+
+    cv::Size getInputSize() const override { return inputSize_; }
+
+    std::string getBackendName() const override { return "cpu"; }
+
+    int getModelType() const override { return modelType_; }
+
+private:
+    // 根据图像内容计算种子，保证结果可复现
+    uint64_t computeSeed(const cv::Mat& image) const;
+
+    // 生成确定性检测结果（不含模拟耗时）
+    bool generate(const cv::Mat& image, const InferenceParams& params, InferenceOutput& output) const;
+
+    int modelType_;
+    float threshold_;
+    int latencyMs_;
+    int detectionCount_;
+    cv::Size inputSize_;
+    uint32_t keypointStride_;
+};
+
+#endif // CPU_REFERENCE_ENGINE_H
@@ -0,0 +1,189 @@
+//
+// Created by YJK on 2026/10/16.
+//
+
+#ifndef INFERENCE_ENGINE_H
+#define INFERENCE_ENGINE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "opencv2/opencv.hpp"
+
+/**
+ * @brief 单次推理的输入参数
+ * 除图像以外由请求携带的参数（如仪表读数的量程）
+ */
+struct InferenceParams {
+    double startValue = 0.0;
+    double endValue = 0.0;
+};
+
+/**
+ * @brief 单次推理的输出结果（按列存储）
+ * 第 i 个目标的检测框为 boxes[4i, 4i+4)（x1, y1, x2, y2），置信度为 scores[i]，类别为 classIds[i]，
+ * 关键点等附加数值为 keypoints[keypointOffsets[i], keypointOffsets[i+1])；
+ * clear() 保留容量，复用同一对象时不再产生分配
+ */
+struct InferenceOutput {
+    std::vector<float> boxes;
+    std::vector<float> scores;
+    std::vector<int> classIds;
+    std::vector<float> keypoints;
+    std::vector<uint32_t> keypointOffsets{0};
+
+    // 每个关键点占用的附加数值个数，前两个为 x、y（0 表示附加数值不是坐标），由引擎按模型配置填写
+    uint32_t keypointStride = 0;
+
+    // 车牌识别结果
+    std::vector<std::string> plateResults;
+
+    // 仪表读数
+    double value = 0.0;
+
+    /**
+     * @brief 目标数量
+     */
+    size_t size() const { return scores.size(); }
+
+    void reserve(size_t count) {
+        boxes.reserve(count * 4);
+        scores.reserve(count);
+        classIds.reserve(count);
+        keypointOffsets.reserve(count + 1);
+    }
+
+    /**
+     * @brief 追加一个目标
+     */
+    void addDetection(float x1, float y1, float x2, float y2, float score, int classId) {
+        boxes.insert(boxes.end(), {x1, y1, x2, y2});
+        scores.push_back(score);
+        classIds.push_back(classId);
+        keypointOffsets.push_back(static_cast<uint32_t>(keypoints.size()));
+    }
+
+    /**
+     * @brief 为最后一个目标追加附加数值
+     */
+    void addKeypoint(float v) {
+        keypoints.push_back(v);
+        keypointOffsets.back() = static_cast<uint32_t>(keypoints.size());
+    }
+
+    /**
+     * @brief 把检测框和关键点坐标从推理或解码尺寸换算回原图尺寸（引擎缩放输入、降采样解码后使用）
+     * 关键点按 keypointStride 分组，只换算每组的 x、y；keypointStride 为 0 时附加数值保持不变
+     */
+    void scaleBoxes(double scaleX, double scaleY) {
+        for (size_t i = 0; i < boxes.size(); i += 4) {
+            boxes[i] = static_cast<float>(boxes[i] * scaleX);
+            boxes[i + 1] = static_cast<float>(boxes[i + 1] * scaleY);
+            boxes[i + 2] = static_cast<float>(boxes[i + 2] * scaleX);
+            boxes[i + 3] = static_cast<float>(boxes[i + 3] * scaleY);
+        }
+
+        if (keypointStride < 2) {
+            return;
+        }
+        for (size_t i = 0; i + 1 < keypointOffsets.size(); ++i) {
+            for (uint32_t k = keypointOffsets[i]; k + 1 < keypointOffsets[i + 1]; k += keypointStride) {
+                keypoints[k] = static_cast<float>(keypoints[k] * scaleX);
+                keypoints[k + 1] = static_cast<float>(keypoints[k + 1] * scaleY);
+            }
+        }
+    }
+
+    void clear() {
+        boxes.clear();
+        scores.clear();
+        classIds.clear();
+        keypoints.clear();
+        keypointOffsets.assign(1, 0);
+        keypointStride = 0;
+        plateResults.clear();
+        value = 0.0;
+    }
+};
+
+/**
+ * @brief 推理引擎创建参数
+ */
+struct EngineCreateInfo {
+    std::string backend;        // 推理后端名称，如 "rknn"、"cpu"
+    std::string modelPath;      // 模型文件路径
+    int modelType = 1;          // 模型类型
+    float threshold = 0.5f;     // 检测阈值
+    size_t instanceIndex = 0;   // 实例在模型池中的序号
+    std::vector<int> npuCores;  // 实例按序号轮流绑定的NPU核心（为空时由后端决定）
+    int inputWidth = 0;         // 模型输入尺寸（0 表示未知）
+    int inputHeight = 0;
+    int keypointStride = 0;     // 每个关键点的附加数值个数（前两个为 x、y，0 表示不是坐标）
+
+    // CPU参考后端参数
+    int cpuLatencyMs = 0;       // 模拟推理耗时（毫秒）
+    int cpuDetectionCount = 3;  // 每帧生成的检测框数量
+};
+
+/**
+ * @brief 推理引擎抽象接口
+ * 屏蔽具体推理后端（NPU、CPU参考实现等），模型池只依赖该接口
+ */
+class InferenceEngine {
+public:
+    virtual ~InferenceEngine() = default;
+
+    /**
+     * @brief 执行一次推理
+     * @param image 输入图像（BGR）
+     * @param params 推理参数
+     * @param output 推理结果
+     * @return 推理是否成功
+     */
+    virtual bool infer(const cv::Mat& image, const InferenceParams& params, InferenceOutput& output) = 0;
+
+    /**
+     * @brief 批量推理
+     * 默认实现逐张调用 infer()，支持多batch输入的后端可重写为一次调用
+     * @param images 输入图像
+     * @param params 每张图像对应的推理参数
+     * @param outputs 每张图像对应的推理结果（调用方预先分配好大小）
+     * @param success 每张图像是否推理成功（调用方预先分配好大小）
+     */
+    virtual void inferBatch(const std::vector<cv::Mat>& images,
+                            const std::vector<InferenceParams>& params,
+                            std::vector<InferenceOutput>& outputs,
+                            std::vector<char>& success) {
+        for (size_t i = 0; i < images.size(); ++i) {
+            success[i] = infer(images[i], params[i], outputs[i]) ? 1 : 0;
+        }
+    }
+
+    /**
+     * @brief 归还实例时重置单次请求的状态
+     * 只清空内容、保留容量，结果存储和中间缓冲区保持在历史最高容量，下次请求不再重新分配
+     */
+    virtual void releaseResources() = 0;
+
+    /**
+     * @brief 回收工作集内存（由模型池在实例空闲超过 trim 时长后调用）
+     */
+    virtual void trimResources() {}
+
+    /**
+     * @brief 模型输入尺寸，解码阶段据此选择降采样解码；未知时返回空尺寸
+     */
+    virtual cv::Size getInputSize() const { return cv::Size(); }
+
+    /**
+     * @brief 获取后端名称
+     */
+    virtual std::string getBackendName() const = 0;
+
+    /**
+     * @brief 获取模型类型
+     */
+    virtual int getModelType() const = 0;
+};
+
+#endif // INFERENCE_ENGINE_H
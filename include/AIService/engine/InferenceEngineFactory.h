@@ -0,0 +1,63 @@
+//
+// Created by YJK on 2026/10/16.
+//
+
+#ifndef INFERENCE_ENGINE_FACTORY_H
+#define INFERENCE_ENGINE_FACTORY_H
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "AIService/engine/InferenceEngine.h"
+
+/**
+ * @brief 推理引擎工厂
+ * 按 (后端名称, 模型类型) 查找创建函数；模型类型为 ANY_MODEL_TYPE 的注册项作为该后端的默认实现
+ */
+class InferenceEngineFactory {
+public:
+    using Creator = std::function<std::shared_ptr<InferenceEngine>(const EngineCreateInfo&)>;
+
+    static constexpr int ANY_MODEL_TYPE = 0;
+
+    /**
+     * @brief 注册引擎创建函数
+     * @param backend 后端名称
+     * @param modelType 模型类型，ANY_MODEL_TYPE 表示该后端的默认实现
+     * @param creator 创建函数
+     * @param requiresModelFile 该后端是否需要模型文件
+     */
+    static void registerCreator(const std::string& backend, int modelType, Creator creator,
+                                bool requiresModelFile = true);
+
+    /**
+     * @brief 创建推理引擎
+     * @param info 创建参数
+     * @return 引擎实例，找不到对应后端时返回nullptr
+     */
+    static std::shared_ptr<InferenceEngine> create(const EngineCreateInfo& info);
+
+    /**
+     * @brief 检查后端是否已注册
+     */
+    static bool hasBackend(const std::string& backend);
+
+    /**
+     * @brief 检查后端是否需要模型文件
+     */
+    static bool requiresModelFile(const std::string& backend);
+
+private:
+    InferenceEngineFactory() = delete;
+
+    // 注册内置后端
+    static void registerBuiltinEngines();
+
+    static std::map<std::string, std::map<int, Creator>>& registry();
+    static std::map<std::string, bool>& modelFileRequirements();
+    static std::mutex registryMutex_;
+};
+
+#endif // INFERENCE_ENGINE_FACTORY_H
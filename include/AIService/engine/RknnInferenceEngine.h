@@ -0,0 +1,43 @@
+//
+// Created by YJK on 2026/10/16.
+//
+
+#ifndef RKNN_INFERENCE_ENGINE_H
+#define RKNN_INFERENCE_ENGINE_H
+
+#include <memory>
+#include "AIService/engine/InferenceEngine.h"
+#include "AIService/rknn/rknnPool.h"
+
+/**
+ * @brief RK3588 NPU推理引擎
+ * 对 rknn_lite 的适配封装；配置了模型输入尺寸时由实例自己的输入缓冲完成缩放，
+ * rknn_lite 内部的颜色转换与输出张量不接受外部缓冲区，仍由其自行分配
+ */
+class RknnInferenceEngine : public InferenceEngine {
+public:
+    explicit RknnInferenceEngine(const EngineCreateInfo& info);
+
+    bool infer(const cv::Mat& image, const InferenceParams& params, InferenceOutput& output) override;
+
+    void releaseResources() override;
+
+    void trimResources() override;
+
+    cv::Size getInputSize() const override { return inputSize_; }
+
+    std::string getBackendName() const override { return "rknn"; }
+
+    int getModelType() const override { return modelType_; }
+
+private:
+    std::unique_ptr<rknn_lite> model_;
+    int modelType_;
+    cv::Size inputSize_;
+    uint32_t keypointStride_;
+
+    // 缩放到模型输入尺寸的输入图像，实例内跨请求复用，空闲回收时释放
+    cv::Mat inputBuffer_;
+};
+
+#endif // RKNN_INFERENCE_ENGINE_H
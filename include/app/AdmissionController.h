@@ -0,0 +1,173 @@
+//
+// Created by YJK on 2026/10/16.
+//
+
+#ifndef ADMISSION_CONTROLLER_H
+#define ADMISSION_CONTROLLER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+/**
+ * @brief 请求准入控制器
+ * HTTP 与 gRPC 推理入口共用：限制同时处理的请求数（max_concurrent_requests），
+ * 超出部分进入有界等待队列（max_queued_requests），队列已满时立即拒绝；
+ * 每个请求携带截止时间（request_timeout_ms），过期的请求在解码前即被丢弃
+ */
+class AdmissionController {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief 准入结果
+     */
+    enum class Status {
+        ADMITTED,           // 已准入
+        QUEUE_FULL,         // 等待队列已满，被拒绝
+        DEADLINE_EXCEEDED,  // 排队期间已超过截止时间
+        SHUTDOWN            // 服务正在关闭
+    };
+
+    /**
+     * @brief 准入凭证（RAII）
+     * 析构时归还并发名额
+     */
+    class Permit {
+    public:
+        Permit() = default;
+        ~Permit() { release(); }
+
+        // 禁止拷贝
+        Permit(const Permit&) = delete;
+        Permit& operator=(const Permit&) = delete;
+
+        // 支持移动
+        Permit(Permit&& other) noexcept
+                : controller_(other.controller_), status_(other.status_), deadline_(other.deadline_) {
+            other.controller_ = nullptr;
+        }
+
+        Permit& operator=(Permit&& other) noexcept {
+            if (this != &other) {
+                release();
+                controller_ = other.controller_;
+                status_ = other.status_;
+                deadline_ = other.deadline_;
+                other.controller_ = nullptr;
+            }
+            return *this;
+        }
+
+        bool admitted() const { return status_ == Status::ADMITTED; }
+
+        Status status() const { return status_; }
+
+        Clock::time_point deadline() const { return deadline_; }
+
+        /**
+         * @brief 截止时间是否已过
+         */
+        bool expired() const { return Clock::now() >= deadline_; }
+
+        /**
+         * @brief 距截止时间的剩余毫秒数（已过期时为0）
+         */
+        int remainingMs() const;
+
+        /**
+         * @brief 用剩余时间约束下游超时（如模型获取超时）
+         * @param timeoutMs 下游原本的超时时间（毫秒）
+         * @return min(timeoutMs, 剩余时间)，已过期时为0
+         */
+        int boundTimeout(int timeoutMs) const;
+
+    private:
+        friend class AdmissionController;
+
+        Permit(AdmissionController* controller, Status status, Clock::time_point deadline)
+                : controller_(controller), status_(status), deadline_(deadline) {}
+
+        void release();
+
+        AdmissionController* controller_ = nullptr;
+        Status status_ = Status::SHUTDOWN;
+        Clock::time_point deadline_{};
+    };
+
+    /**
+     * @brief 构造函数
+     * @param maxConcurrent 最大并发处理数（<=0 表示不限制）
+     * @param maxQueued 最大排队数（<=0 表示不排队，超出并发直接拒绝）
+     */
+    AdmissionController(int maxConcurrent, int maxQueued);
+
+    // 禁止拷贝
+    AdmissionController(const AdmissionController&) = delete;
+    AdmissionController& operator=(const AdmissionController&) = delete;
+
+    /**
+     * @brief 申请准入，必要时排队等待直到截止时间
+     * @param deadline 请求截止时间
+     * @return 准入凭证，调用方需检查 admitted()
+     */
+    Permit admit(Clock::time_point deadline);
+
+    /**
+     * @brief 记录一次已准入但在处理前过期而被丢弃的请求
+     */
+    void recordExpired() { expiredRequests_++; }
+
+    /**
+     * @brief 记录一次在准入之前（如异步调用排队已满）被拒绝的请求
+     */
+    void recordRejected() { rejectedRequests_++; }
+
+    /**
+     * @brief 关闭控制器，唤醒所有排队的请求
+     */
+    void shutdown();
+
+    /**
+     * @brief 准入结果的描述文本
+     */
+    static const char* statusToString(Status status);
+
+    /**
+     * @brief 准入统计信息
+     */
+    struct Stats {
+        int active;
+        int queued;
+        int maxConcurrent;
+        int maxQueued;
+        size_t admitted;
+        size_t rejected;
+        size_t timedOut;
+        size_t expired;
+    };
+
+    Stats getStats() const;
+
+private:
+    // 归还并发名额
+    void release();
+
+    const int maxConcurrent_;
+    const int maxQueued_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable condition_;
+    int active_ = 0;
+    int queued_ = 0;
+    bool shutdown_ = false;
+
+    // 统计信息
+    std::atomic<size_t> admittedRequests_{0};
+    std::atomic<size_t> rejectedRequests_{0};
+    std::atomic<size_t> timedOutRequests_{0};
+    std::atomic<size_t> expiredRequests_{0};
+};
+
+#endif // ADMISSION_CONTROLLER_H
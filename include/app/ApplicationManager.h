@@ -8,6 +8,9 @@
 #include "common/Logger.h"
 #include "common/StreamConfig.h"
 #include "AIService/ModelPool.h"
+#include "AIService/BatchScheduler.h"
+#include "AIService/InferencePipeline.h"
+#include "app/AdmissionController.h"
 #include <string>
 #include <memory>
 #include <mutex>
@@ -26,10 +29,25 @@ class GrpcServiceInitializerBase;
  */
 struct ConcurrencyConfig {
     int maxConcurrentRequests = 10;
+    int maxQueuedRequests = 20;
     int modelPoolSize = 3;
     int requestTimeoutMs = 30000;
     int modelAcquireTimeoutMs = 5000;
     bool enableConcurrencyMonitoring = true;
+    int poolSpinIterations = 100;
+    bool poolThreadAffinity = true;
+    int batchMaxSize = 1;        // 动态批处理最大批大小（1表示不启用）
+    int batchMaxWaitMs = 2;      // 凑批最长等待时间（毫秒）
+    bool poolAutoscale = false;          // 模型池弹性伸缩
+    int poolScaleUpWaitMs = 20;          // 获取等待p95超过该值时扩容（毫秒）
+    int poolScaleDownIdleMs = 60000;     // 实例持续多余该时长后回收（毫秒）
+    int poolScaleIntervalMs = 1000;      // 伸缩评估周期（毫秒）
+    int poolTrimIdleMs = 60000;          // 实例空闲超过该时长后回收工作集内存（毫秒，0 不回收）
+    int framePoolMaxCachedMb = 256;      // 解码缓冲池空闲缓存上限（MB，0 不缓存）
+    bool pipelineEnabled = false;        // 分阶段推理流水线（解码/推理/序列化）
+    int pipelineDecodeThreads = 0;       // 解码线程数
+    int pipelineSerializeThreads = 2;    // 序列化线程数
+    int pipelineQueueDepth = 64;         // 每个阶段的队列容量
 };
 
 /**
@@ -64,12 +82,23 @@ private:
     std::unordered_map<int, std::unique_ptr<ModelPool>> modelPools_;
     mutable std::shared_mutex modelPoolsMutex_;
 
+    // 动态批处理调度器（仅在 batch_max_size > 1 时创建）
+    std::unordered_map<int, std::unique_ptr<BatchScheduler>> batchSchedulers_;
+
+    // 分阶段推理流水线（仅在 pipeline_enabled 时创建）
+    std::unique_ptr<InferencePipeline> pipeline_;
+
     // 并发监控
     std::unique_ptr<ConcurrencyMonitor> httpMonitor_;
     std::unique_ptr<ConcurrencyMonitor> grpcMonitor_;
     ConcurrencyConfig concurrencyConfig_;
 
+    // 请求准入控制
+    std::unique_ptr<AdmissionController> admissionController_;
+    std::once_flag admissionInitFlag_;
+
     // 初始化方法
+    bool initializePipeline();
     bool initializeGrpcServer();
     bool initializeRoutes();
     bool startHttpServer();
@@ -77,6 +106,9 @@ private:
     // 记录初始化摘要 - 添加这一行
     void logInitializationSummary();
 
+    // 按模型类型整理推理输出（车牌仅对车牌模型有效，读数仅对仪表模型有效）
+    static bool collectInferenceOutput(int modelType, InferenceOutput& output);
+
 public:
     // 禁止拷贝和移动
     ApplicationManager(const ApplicationManager&) = delete;
@@ -108,6 +140,12 @@ public:
      */
     const HTTPServerConfig& getHTTPServerConfig() const;
 
+    /**
+     * @brief 获取gRPC服务器配置
+     * @return gRPC服务器配置引用
+     */
+    const GRPCServerConfig& getGRPCServerConfig() const;
+
     /**
      * @brief 初始化模型池
      * @return 初始化是否成功
@@ -129,19 +167,22 @@ public:
      * @brief 使用模型池执行推理
      * @param modelType 模型类型
      * @param imageData 图像数据
-     * @param results 检测结果
-     * @param plateResults 车牌结果
+     * @param output 推理结果（检测框、车牌、仪表读数），调用方可复用同一对象
+     * @param startValue 仪表量程起始值
+     * @param endValue 仪表量程终止值
      * @param timeoutMs 超时时间
+     * @param priority 调度属性（优先级、截止时间），用于模型池等待队列排序
+     * @param timings 可选，写入等待模型实例、推理与结果整理三个阶段的耗时
      * @return 执行是否成功
      */
     bool executeModelInference(int modelType,
                                const cv::Mat& imageData,
-                               std::vector<std::vector<std::any>>& results,
-                               std::vector<std::string>& plateResults,
+                               InferenceOutput& output,
                                double startValue,
                                double endValue,
-                               double& targetResult,
-                               int timeoutMs = 0);
+                               int timeoutMs = 0,
+                               const AcquirePriority& priority = AcquirePriority(),
+                               StageTimings* timings = nullptr);
 
     /**
      * @brief 设置模型池状态
@@ -165,12 +206,25 @@ public:
      */
     ModelPool::PoolStatus getModelPoolStatus(int modelType) const;
 
+    /**
+     * @brief 获取模型输入尺寸，供解码阶段选择降采样解码
+     * @param modelType 模型类型
+     * @return 输入尺寸，模型不存在或未配置时为空
+     */
+    cv::Size getModelInputSize(int modelType) const;
+
     /**
      * @brief 获取所有模型池状态
      * @return 所有模型池状态映射
      */
     std::unordered_map<int, ModelPool::PoolStatus> getAllModelPoolStatus() const;
 
+    /**
+     * @brief 获取所有动态批处理调度器的统计信息
+     * @return 模型类型到批处理统计的映射（未启用批处理时为空）
+     */
+    std::unordered_map<int, BatchScheduler::Stats> getAllBatchSchedulerStats() const;
+
     // 并发监控方法
 
     /**
@@ -183,6 +237,32 @@ public:
      */
     ConcurrencyMonitor::Stats getGrpcConcurrencyStats() const;
 
+    /**
+     * @brief 获取HTTP/gRPC并发监控器（未启用并发监控时为nullptr），供指标导出按桶读取直方图
+     */
+    const ConcurrencyMonitor* getHttpMonitor() const { return httpMonitor_.get(); }
+    const ConcurrencyMonitor* getGrpcMonitor() const { return grpcMonitor_.get(); }
+
+    /**
+     * @brief 获取HTTP请求各阶段的延迟统计
+     */
+    std::vector<ConcurrencyMonitor::LatencyStats> getHttpLatencyStats() const;
+
+    /**
+     * @brief 获取gRPC请求各阶段的延迟统计
+     */
+    std::vector<ConcurrencyMonitor::LatencyStats> getGrpcLatencyStats() const;
+
+    /**
+     * @brief 记录一个成功HTTP请求的各阶段耗时
+     */
+    void recordHttpLatency(int modelType, const StageTimings& timings);
+
+    /**
+     * @brief 记录一个成功gRPC请求的各阶段耗时
+     */
+    void recordGrpcLatency(int modelType, const StageTimings& timings);
+
     /**
      * @brief 开始HTTP请求监控
      */
@@ -213,6 +293,25 @@ public:
      */
     void failGrpcRequest();
 
+    /**
+     * @brief 申请推理请求准入
+     * 截止时间为 now + request_timeout_ms，若调用方给出更短的剩余时间则取较小值
+     * @param budgetMs 调用方的剩余时间（毫秒，<=0 表示不限制）
+     * @return 准入凭证，调用方需检查 admitted()
+     */
+    AdmissionController::Permit admitRequest(int budgetMs = 0);
+
+    /**
+     * @brief 获取准入控制器
+     */
+    AdmissionController& getAdmissionController();
+
+    /**
+     * @brief 获取分阶段推理流水线
+     * @return 未启用时返回 nullptr
+     */
+    InferencePipeline* getPipeline() const { return pipeline_.get(); }
+
     /**
      * @brief 获取并发配置
      */
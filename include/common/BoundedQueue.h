@@ -0,0 +1,110 @@
+//
+// Created by YJK on 2026/10/16.
+//
+
+#ifndef BOUNDED_QUEUE_H
+#define BOUNDED_QUEUE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+
+/**
+ * @brief 有界阻塞队列
+ * 满时 push 阻塞（向上游施加背压）、tryPush 立即失败；close 后不再接收新元素，已入队的元素仍可取出
+ */
+template<typename T>
+class BoundedQueue {
+public:
+    /**
+     * @brief 构造函数
+     * @param capacity 容量（至少为1）
+     */
+    explicit BoundedQueue(size_t capacity) : capacity_(capacity > 0 ? capacity : 1) {}
+
+    // 禁止拷贝
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    /**
+     * @brief 入队，队列满时等待
+     * @return 队列已关闭时返回false
+     */
+    bool push(T item) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            notFull_.wait(lock, [this] { return closed_ || items_.size() < capacity_; });
+            if (closed_) {
+                return false;
+            }
+            items_.push_back(std::move(item));
+        }
+        notEmpty_.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief 入队，队列满或已关闭时立即返回false
+     */
+    bool tryPush(T item) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (closed_ || items_.size() >= capacity_) {
+                return false;
+            }
+            items_.push_back(std::move(item));
+        }
+        notEmpty_.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief 出队，队列空时等待
+     * @return 队列已关闭且已取空时返回false
+     */
+    bool pop(T& item) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            notEmpty_.wait(lock, [this] { return closed_ || !items_.empty(); });
+            if (items_.empty()) {
+                return false;
+            }
+            item = std::move(items_.front());
+            items_.pop_front();
+        }
+        notFull_.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief 关闭队列，唤醒所有等待者
+     */
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closed_ = true;
+        }
+        notEmpty_.notify_all();
+        notFull_.notify_all();
+    }
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return items_.size();
+    }
+
+    size_t capacity() const {
+        return capacity_;
+    }
+
+private:
+    const size_t capacity_;
+    std::deque<T> items_;
+    mutable std::mutex mutex_;
+    std::condition_variable notEmpty_;
+    std::condition_variable notFull_;
+    bool closed_ = false;
+};
+
+#endif // BOUNDED_QUEUE_H
@@ -0,0 +1,180 @@
+//
+// Created by YJK on 2026/10/16.
+//
+
+#ifndef FRAME_POOL_H
+#define FRAME_POOL_H
+
+#include <opencv2/opencv.hpp>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief 解码图像缓冲池
+ * 按常见相机分辨率分档缓存64字节对齐的BGR缓冲区；解码前先从JPEG/PNG头部读出尺寸，
+ * 取出对应档位的缓冲区包成Mat交给 imdecode 的目标Mat重载直接写入，
+ * 请求结束后归还，避免高QPS下每帧数MB的malloc/free与缺页开销；
+ * 给出模型输入尺寸时，远大于输入尺寸的JPEG按 1/2、1/4、1/8 降采样解码（libjpeg DCT缩放）
+ */
+class FramePool {
+public:
+    /**
+     * @brief 已解码图像的租约，析构时把缓冲区归还给池
+     * 只能移动；image() 引用的内存在租约销毁前有效
+     */
+    class Frame {
+    public:
+        Frame() = default;
+        ~Frame() { reset(); }
+
+        Frame(Frame&& other) noexcept;
+        Frame& operator=(Frame&& other) noexcept;
+
+        Frame(const Frame&) = delete;
+        Frame& operator=(const Frame&) = delete;
+
+        cv::Mat& image() { return image_; }
+        const cv::Mat& image() const { return image_; }
+
+        bool empty() const { return image_.empty(); }
+
+        /**
+         * @brief 图像是否写在池中的缓冲区上
+         */
+        bool pooled() const { return buffer_ != nullptr; }
+
+        /**
+         * @brief 原图尺寸（降采样解码时大于 image() 的尺寸）
+         */
+        cv::Size originalSize() const { return originalSize_; }
+
+        /**
+         * @brief 是否降采样解码；是则检测框需乘以 scaleX()/scaleY() 换算回原图
+         */
+        bool reduced() const { return reduced_; }
+
+        double scaleX() const { return scaleX_; }
+
+        double scaleY() const { return scaleY_; }
+
+        /**
+         * @brief 释放图像并归还缓冲区
+         */
+        void reset();
+
+    private:
+        friend class FramePool;
+
+        cv::Mat image_;
+        unsigned char* buffer_ = nullptr;
+        int sizeClass_ = -1;
+        cv::Size originalSize_;
+        bool reduced_ = false;
+        double scaleX_ = 1.0;
+        double scaleY_ = 1.0;
+    };
+
+    /**
+     * @brief 统计信息
+     */
+    struct Stats {
+        uint64_t hits = 0;           // 复用了缓存的缓冲区
+        uint64_t misses = 0;         // 档位内没有空闲缓冲区，新分配
+        uint64_t unpooled = 0;       // 尺寸无法识别、超出最大档位或解码时改变了尺寸，走普通解码
+        uint64_t evictions = 0;      // 归还时超出缓存上限而直接释放
+        uint64_t reduced = 0;        // 降采样解码次数
+        size_t cachedBuffers = 0;
+        size_t cachedBytes = 0;
+        size_t maxCachedBytes = 0;
+        size_t leasedBuffers = 0;
+    };
+
+    static FramePool& getInstance();
+
+    // 禁止拷贝
+    FramePool(const FramePool&) = delete;
+    FramePool& operator=(const FramePool&) = delete;
+
+    /**
+     * @brief 设置空闲缓冲区的缓存上限
+     * @param maxCachedBytes 字节数，0 表示不缓存（每次解码都直接分配）
+     */
+    void configure(size_t maxCachedBytes);
+
+    /**
+     * @brief 预先分配并触碰缓冲区，避免首批请求的缺页
+     * @param width 图像宽
+     * @param height 图像高
+     * @param count 缓冲区个数
+     * @return 实际放入缓存的个数（受缓存上限约束）
+     */
+    size_t preallocate(int width, int height, size_t count);
+
+    /**
+     * @brief 解码编码后的图像（JPEG/PNG等）
+     * 能从头部读出尺寸且落在分档范围内时写入池中缓冲区，否则退回普通 imdecode
+     * @param data 编码数据
+     * @param size 数据长度
+     * @param flags imdecode 标志，目前只有 IMREAD_COLOR 使用池和降采样解码
+     * @param frame 输出租约
+     * @param targetSize 模型输入尺寸，为空时按原尺寸解码
+     * @return 解码是否成功
+     */
+    bool decode(const unsigned char* data, size_t size, int flags, Frame& frame,
+                const cv::Size& targetSize = cv::Size());
+
+    /**
+     * @brief 降采样倍数（1、2、4、8）
+     * 取不超过 max(宽/输入宽, 高/输入高) 的最大倍数，保证按比例缩放到模型输入时仍是缩小
+     */
+    static int reducedScale(int width, int height, const cv::Size& targetSize);
+
+    Stats getStats() const;
+
+    /**
+     * @brief 从JPEG（SOF段）或PNG（IHDR块）头部读出图像尺寸，不解码像素
+     * @return 识别成功返回 true
+     */
+    static bool peekImageSize(const unsigned char* data, size_t size, int& width, int& height);
+
+private:
+    FramePool();
+    ~FramePool() = default;
+
+    static constexpr size_t ALIGNMENT = 64;
+    static constexpr size_t SIZE_CLASS_COUNT = 6;
+
+    struct SizeClass {
+        int width = 0;
+        int height = 0;
+        size_t bytes = 0;                     // BGR 字节数，已按对齐向上取整
+        std::mutex mutex;
+        std::vector<unsigned char*> freeBuffers;
+    };
+
+    /**
+     * @brief 能容纳 bytes 字节的最小档位，超出最大档位返回 -1
+     */
+    int sizeClassFor(size_t bytes) const;
+
+    unsigned char* acquireBuffer(int sizeClass);
+    void releaseBuffer(int sizeClass, unsigned char* buffer);
+
+    std::array<SizeClass, SIZE_CLASS_COUNT> classes_;
+
+    std::atomic<size_t> maxCachedBytes_{0};
+    std::atomic<size_t> cachedBytes_{0};
+    std::atomic<size_t> cachedBuffers_{0};
+    std::atomic<size_t> leasedBuffers_{0};
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+    std::atomic<uint64_t> unpooled_{0};
+    std::atomic<uint64_t> evictions_{0};
+    std::atomic<uint64_t> reduced_{0};
+};
+
+#endif // FRAME_POOL_H
@@ -0,0 +1,82 @@
+//
+// Created by YJK on 2026/10/16.
+//
+
+#ifndef JSON_WRITER_H
+#define JSON_WRITER_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief 单遍JSON写入器
+ * 直接向调用方提供的缓冲区追加紧凑格式的JSON文本，不构建DOM；
+ * 浮点数默认按四位小数四舍五入后以最短形式输出（与 any_to_json 的取整一致），需要完整精度时用 exactValue，
+ * 调用方负责保证 begin/end 成对出现以及对象中 key 与值交替出现
+ */
+class JsonWriter {
+public:
+    /**
+     * @brief 构造函数
+     * @param out 输出缓冲区，写入前不会被清空
+     */
+    explicit JsonWriter(std::string& out) : out_(out) {}
+
+    JsonWriter& beginObject();
+    JsonWriter& endObject();
+    JsonWriter& beginArray();
+    JsonWriter& endArray();
+
+    /**
+     * @brief 写入对象的键（键名不做转义，需为普通ASCII）
+     */
+    JsonWriter& key(std::string_view name);
+
+    /**
+     * @brief 写入整数
+     */
+    template <typename T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>, int> = 0>
+    JsonWriter& value(T v) {
+        if constexpr (std::is_signed_v<T>) {
+            return writeSigned(static_cast<int64_t>(v));
+        } else {
+            return writeUnsigned(static_cast<uint64_t>(v));
+        }
+    }
+
+    JsonWriter& value(bool v);
+
+    /**
+     * @brief 写入浮点数（四位小数），NaN/Inf 输出为 null
+     */
+    JsonWriter& value(double v);
+    JsonWriter& value(float v) { return value(static_cast<double>(v)); }
+
+    /**
+     * @brief 写入浮点数（完整精度，与 nlohmann 的 dump 输出一致），NaN/Inf 输出为 null
+     */
+    JsonWriter& exactValue(double v);
+
+    /**
+     * @brief 写入字符串（按JSON规则转义）
+     */
+    JsonWriter& value(std::string_view v);
+    JsonWriter& value(const char* v) { return value(std::string_view(v)); }
+    JsonWriter& value(const std::string& v) { return value(std::string_view(v)); }
+
+private:
+    JsonWriter& writeSigned(int64_t v);
+    JsonWriter& writeUnsigned(uint64_t v);
+
+    // 在数组元素或对象成员之间插入逗号
+    void separate();
+
+    std::string& out_;
+    std::vector<bool> first_;   // 每层容器是否尚未写入元素
+    bool afterKey_ = false;     // 刚写完键，下一个值不需要逗号
+};
+
+#endif // JSON_WRITER_H
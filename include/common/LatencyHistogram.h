@@ -0,0 +1,140 @@
+//
+// Created by YJK on 2026/10/16.
+//
+
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @brief 无锁延迟直方图（HDR 风格的对数-线性分桶）
+ * 以微秒记录，每个2的幂区间再均分为16个子桶，相对误差不超过1/16；
+ * 记录只有几次 relaxed 原子加，可在请求路径上直接调用
+ */
+class LatencyHistogram {
+public:
+    /**
+     * @brief 分位数快照（单位：微秒）
+     */
+    struct Snapshot {
+        uint64_t count = 0;
+        double meanUs = 0.0;
+        uint64_t p50Us = 0;
+        uint64_t p90Us = 0;
+        uint64_t p99Us = 0;
+        uint64_t p999Us = 0;
+        uint64_t maxUs = 0;
+    };
+
+    LatencyHistogram() = default;
+
+    // 禁止拷贝
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    /**
+     * @brief 记录一个延迟值
+     * @param micros 微秒，超过上限的值计入最后一个桶
+     */
+    void record(uint64_t micros);
+
+    /**
+     * @brief 生成快照（与并发记录之间不保证严格一致）
+     */
+    Snapshot snapshot() const;
+
+    /**
+     * @brief 单个分位数（取所在桶的上界），没有记录时返回0
+     * @param quantile 0~1
+     */
+    uint64_t valueAtQuantile(double quantile) const;
+
+    /**
+     * @brief 按桶遍历，供指标导出使用
+     * @param visitor 参数为 (桶上界微秒, 桶内计数)，只访问非空桶
+     */
+    template<typename Visitor>
+    void forEachBucket(Visitor&& visitor) const {
+        for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+            uint64_t n = counts_[i].load(std::memory_order_relaxed);
+            if (n > 0) {
+                visitor(bucketUpperBound(i), n);
+            }
+        }
+    }
+
+    uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+
+    uint64_t sumMicros() const { return sum_.load(std::memory_order_relaxed); }
+
+    void reset();
+
+private:
+    static constexpr int SUB_BUCKET_BITS = 5;                              // 前32个值逐一计数
+    static constexpr uint64_t SUB_BUCKET_COUNT = 1ULL << SUB_BUCKET_BITS;
+    static constexpr uint64_t SUB_BUCKET_HALF = SUB_BUCKET_COUNT / 2;
+    static constexpr int MAX_VALUE_BITS = 36;                              // 约19小时
+    static constexpr size_t BUCKET_COUNT =
+            SUB_BUCKET_COUNT + (MAX_VALUE_BITS - SUB_BUCKET_BITS) * SUB_BUCKET_HALF;
+
+    static size_t bucketIndex(uint64_t micros);
+    static uint64_t bucketLowerBound(size_t index);
+    static uint64_t bucketUpperBound(size_t index);
+
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> counts_{};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sum_{0};
+    std::atomic<uint64_t> max_{0};
+};
+
+/**
+ * @brief 推理请求的处理阶段
+ */
+enum class LatencyStage {
+    ADMISSION,       // 准入排队
+    PARSE,           // 请求解析（JSON）
+    BASE64_DECODE,   // Base64 解码
+    IMAGE_DECODE,    // cv::imdecode
+    POOL_WAIT,       // 等待模型实例（含批处理凑批）
+    INFERENCE,       // 模型推理（含引擎内部前后处理）
+    POSTPROCESS,     // 推理结果整理
+    SERIALIZE,       // 响应序列化
+    TOTAL,           // 请求总耗时
+    COUNT
+};
+
+/**
+ * @brief 阶段名称，用于状态接口与指标导出
+ */
+const char* latencyStageName(LatencyStage stage);
+
+/**
+ * @brief 单个请求各阶段的耗时（微秒），未经过的阶段为 -1
+ */
+struct StageTimings {
+    using Clock = std::chrono::steady_clock;
+
+    std::array<int64_t, static_cast<size_t>(LatencyStage::COUNT)> micros;
+
+    StageTimings() { micros.fill(-1); }
+
+    void set(LatencyStage stage, Clock::time_point begin, Clock::time_point end) {
+        micros[static_cast<size_t>(stage)] =
+                std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+    }
+
+    /**
+     * @brief 记录从 begin 到现在的耗时，并返回当前时间供下一阶段使用
+     */
+    Clock::time_point mark(LatencyStage stage, Clock::time_point begin) {
+        auto now = Clock::now();
+        set(stage, begin, now);
+        return now;
+    }
+};
+
+#endif // LATENCY_HISTOGRAM_H
@@ -0,0 +1,134 @@
+//
+// Created by YJK on 2026/10/16.
+//
+
+#ifndef LOCK_FREE_QUEUE_H
+#define LOCK_FREE_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief 自旋等待时让出流水线资源
+ */
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    asm volatile("yield" ::: "memory");
+#endif
+}
+
+/**
+ * @brief 有界无锁多生产者多消费者队列（Vyukov算法）
+ * 容量向上取整为2的幂，队列满时push返回false，队列空时pop返回false
+ */
+template <typename T>
+class BoundedMpmcQueue {
+public:
+    explicit BoundedMpmcQueue(size_t capacity = 0) {
+        reset(capacity);
+    }
+
+    BoundedMpmcQueue(const BoundedMpmcQueue&) = delete;
+    BoundedMpmcQueue& operator=(const BoundedMpmcQueue&) = delete;
+
+    /**
+     * @brief 重新分配队列（非线程安全，只能在没有并发访问时调用）
+     * @param capacity 最小容量
+     */
+    void reset(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+
+        mask_ = size - 1;
+        cells_.reset(new Cell[size]);
+        for (size_t i = 0; i < size; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        enqueuePos_.store(0, std::memory_order_relaxed);
+        dequeuePos_.store(0, std::memory_order_relaxed);
+    }
+
+    bool push(const T& value) {
+        Cell* cell;
+        size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &cells_[pos & mask_];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false; // 队列已满
+            } else {
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->data = value;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T& value) {
+        Cell* cell;
+        size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &cells_[pos & mask_];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false; // 队列为空
+            } else {
+                pos = dequeuePos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        value = cell->data;
+        cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief 近似元素数量（仅用于统计）
+     */
+    size_t sizeApprox() const {
+        size_t enqueued = enqueuePos_.load(std::memory_order_relaxed);
+        size_t dequeued = dequeuePos_.load(std::memory_order_relaxed);
+        return enqueued > dequeued ? enqueued - dequeued : 0;
+    }
+
+    size_t capacity() const { return mask_ + 1; }
+
+private:
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T data;
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    size_t mask_ = 0;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> enqueuePos_{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> dequeuePos_{0};
+};
+
+#endif // LOCK_FREE_QUEUE_H
@@ -9,7 +9,20 @@
 #include <ctime>
 #include <sys/stat.h>
 #include <dirent.h>
+#include <algorithm>
 #include <atomic>
+#include <cstdio>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <thread>
+
+// 编译期日志级别下限：低于该级别的 LOGGER_* 调用整体移除，消息表达式不会被求值
+// 0=DEBUG, 1=INFO, 2=WARNING, 3=ERROR, 4=FATAL（Release 构建默认为1，见 CMakeLists.txt）
+#ifndef LOGGER_MIN_LEVEL
+#define LOGGER_MIN_LEVEL 0
+#endif
 
 enum class LogLevel {
     DEBUG,
@@ -19,6 +32,45 @@ enum class LogLevel {
     FATAL
 };
 
+namespace logger_detail {
+
+    // {} 占位符参数的追加函数（定义见 Logger.cpp）
+    void appendArg(std::string& out, bool value);
+    void appendArg(std::string& out, char value);
+    void appendArg(std::string& out, int value);
+    void appendArg(std::string& out, long value);
+    void appendArg(std::string& out, long long value);
+    void appendArg(std::string& out, unsigned value);
+    void appendArg(std::string& out, unsigned long value);
+    void appendArg(std::string& out, unsigned long long value);
+    void appendArg(std::string& out, double value);
+    void appendArg(std::string& out, const char* value);
+    void appendArg(std::string& out, std::string_view value);
+    void appendArg(std::string& out, const std::string& value);
+    void appendArg(std::string& out, const void* value);
+
+    // 类型擦除后的格式化参数
+    struct FormatArg {
+        void (*append)(std::string& out, const void* value);
+        const void* value;
+    };
+
+    template <typename T>
+    FormatArg makeFormatArg(const T& value) {
+        return {[](std::string& out, const void* p) { appendArg(out, *static_cast<const T*>(p)); }, &value};
+    }
+
+    // 按 fmt 风格格式化：{} 依次替换为参数，{{ 和 }} 输出花括号
+    void formatArgs(std::string& out, std::string_view fmt, const FormatArg* args, size_t count);
+
+    template <typename... Args>
+    void formatTo(std::string& out, std::string_view fmt, const Args&... args) {
+        const FormatArg argArray[] = {makeFormatArg(args)..., FormatArg{nullptr, nullptr}};
+        formatArgs(out, fmt, argArray, sizeof...(Args));
+    }
+
+} // namespace logger_detail
+
 class Logger {
 public:
     // 初始化日志系统
@@ -36,6 +88,33 @@ public:
     // 关闭过程中的日志
     static void shutdownMessage(const std::string& message);
 
+    // 等待后台写线程把已提交的日志全部写出
+    static void flush();
+
+    // 因线程环形缓冲已满而丢弃的日志条数
+    static uint64_t getDroppedCount();
+
+    // 运行期级别判断，LOGGER_* 宏在构造消息之前调用
+    static bool isEnabled(LogLevel level) {
+        if (level < minimumLevel.load(std::memory_order_relaxed)) {
+            return false;
+        }
+        return level == LogLevel::FATAL || shutdownPhase.load(std::memory_order_relaxed) < 2;
+    }
+
+    // 记录一条已构造好的消息（不要求以 std::string 形式存在）
+    static void logMessage(LogLevel level, std::string_view message, const char* file, int line, const char* function);
+
+    // fmt 风格格式化后记录，格式化缓冲为线程私有并复用，稳定后不分配内存
+    template <typename... Args>
+    static void logFormat(LogLevel level, const char* file, int line, const char* function,
+                          std::string_view fmt, const Args&... args) {
+        std::string& buffer = formatBuffer();
+        buffer.clear();
+        logger_detail::formatTo(buffer, fmt, args...);
+        logMessage(level, buffer, file, line, function);
+    }
+
     // 原有的日志方法（保持不变）
     static void debug(const std::string& message);
     static void info(const std::string& message);
@@ -51,21 +130,57 @@ public:
     static void fatalWithLocation(const std::string& message, const char* file, int line, const char* function);
 
 private:
+    // 每个线程独占的单生产者/单消费者环形缓冲（定义见 Logger.cpp）
+    struct LogRing;
+
+    // 后台写线程的取出状态（定义见 Logger.cpp）
+    struct WriterState;
+
     // 记录日志的主要方法
-    static void log(LogLevel level, const std::string& message);
+    static void log(LogLevel level, std::string_view message);
 
     // 新增：带位置信息的日志记录方法
-    static void logWithLocation(LogLevel level, const std::string& message,
+    static void logWithLocation(LogLevel level, std::string_view message,
                                 const char* file, int line, const char* function);
 
+    // 写入当前线程的环形缓冲，后台写线程未运行时同步写出
+    static void enqueue(LogLevel level, std::string_view message,
+                        const char* file, int line, const char* function, bool mustDeliver);
+
+    // 同步写出一条日志（后台写线程启动前或停止后使用）
+    static void writeDirect(LogLevel level, std::string_view message,
+                            const char* file, int line, const char* function);
+
+    // 当前线程的 fmt 格式化缓冲
+    static std::string& formatBuffer();
+
+    // 获取当前线程的环形缓冲，首次调用时注册
+    static LogRing& threadRing();
+
+    // 启动/停止后台写线程，停止前会写完所有缓冲中的日志
+    static void startWriter();
+    static void stopWriter();
+
+    // 后台写线程主循环
+    static void writerLoop();
+
+    // 取出所有环形缓冲中的日志并批量写出，返回是否写出了内容
+    static bool drainRings(WriterState& state);
+
+    // 唤醒处于空闲等待的后台写线程
+    static void wakeWriter();
+
     // 获取当前日期的日志文件路径
     static std::string getCurrentLogFilePath();
 
     // 检查并清理旧的日志文件
     static void cleanupOldLogs();
 
-    // 检查并切换日志文件（如果需要）
-    static void checkAndRotateLogFile();
+    // 检查并切换日志文件（如果需要），调用方需持有 logMutex
+    static void checkAndRotateLogFile(const std::string& todayDate);
+
+    // 打开当前日期的日志文件，调用方需持有 logMutex
+    static bool openLogFile();
 
     // 创建目录（如果不存在）
     static bool createDirectory(const std::string& path);
@@ -76,70 +191,93 @@ private:
     // 获取目录中的所有文件
     static std::vector<std::string> getFilesInDirectory(const std::string& directory);
 
-    // 提取文件名（去除路径）
-    static std::string extractFilename(const char* filepath);
-
     // 使用原子变量避免竞态条件
     static std::atomic<bool> isShuttingDown;
     static std::atomic<int> shutdownPhase; // 0=正常, 1=准备关闭, 2=最终关闭
 
     // 静态成员变量
     static std::mutex logMutex;
-    static std::ofstream logFile;
+    static int logFd;
     static bool initialized;
     static bool useFileOutput;
-    static LogLevel minimumLevel;
+    static std::atomic<LogLevel> minimumLevel;
     static std::string logDirectory;
     static std::string currentLogDate;
     static const int MAX_LOG_DAYS = 30;
+
+    // 异步写出相关
+    static constexpr size_t RING_CAPACITY = 1024;    // 每个线程的环形缓冲条数（2的幂）
+    static constexpr int WRITER_IDLE_WAIT_MS = 500;  // 写线程空闲时的最长等待时间
+    static std::mutex ringsMutex;                    // 保护 rings 注册表
+    static std::vector<std::shared_ptr<LogRing>> rings;
+    static std::atomic<uint64_t> ringsVersion;       // 注册表变化时递增
+    static std::mutex writerMutex;
+    static std::condition_variable writerCondition;
+    static std::condition_variable flushCondition;
+    static std::thread writerThread;
+    static WriterState* writerState;                 // 首次启动写线程时创建，不析构（atexit 钩子中仍会使用）
+    static std::atomic<bool> writerRunning;
+    static std::atomic<bool> writerStopRequested;
+    static std::atomic<bool> writerIdle;
+    static std::atomic<uint64_t> flushRequests;      // flush() 请求序号
+    static std::atomic<uint64_t> flushCompleted;     // 写线程已完成的 flush 序号
+    static std::atomic<uint64_t> droppedMessages;
 };
 
+// 先按编译期下限和运行期级别判断，通过后才求值消息表达式
+#define LOGGER_LOG_IF_ENABLED(level, levelValue, call) \
+    do { if ((levelValue) >= LOGGER_MIN_LEVEL && Logger::isEnabled(level)) { call; } } while(0)
+
 // 带位置信息的日志宏定义（使用安全的前缀避免与OpenCV冲突）
 #define LOGGER_DEBUG(msg) \
-    Logger::debugWithLocation(msg, __FILE__, __LINE__, __FUNCTION__)
+    LOGGER_LOG_IF_ENABLED(LogLevel::DEBUG, 0, Logger::debugWithLocation(msg, __FILE__, __LINE__, __FUNCTION__))
 
 #define LOGGER_INFO(msg) \
-    Logger::infoWithLocation(msg, __FILE__, __LINE__, __FUNCTION__)
+    LOGGER_LOG_IF_ENABLED(LogLevel::INFO, 1, Logger::infoWithLocation(msg, __FILE__, __LINE__, __FUNCTION__))
 
 #define LOGGER_WARNING(msg) \
-    Logger::warningWithLocation(msg, __FILE__, __LINE__, __FUNCTION__)
+    LOGGER_LOG_IF_ENABLED(LogLevel::WARNING, 2, Logger::warningWithLocation(msg, __FILE__, __LINE__, __FUNCTION__))
 
 #define LOGGER_ERROR(msg) \
-    Logger::errorWithLocation(msg, __FILE__, __LINE__, __FUNCTION__)
+    LOGGER_LOG_IF_ENABLED(LogLevel::ERROR, 3, Logger::errorWithLocation(msg, __FILE__, __LINE__, __FUNCTION__))
 
 #define LOGGER_FATAL(msg) \
-    Logger::fatalWithLocation(msg, __FILE__, __LINE__, __FUNCTION__)
-
-// 支持格式化字符串的宏（需要C++20或使用sprintf）
-#define LOGGER_DEBUG_FMT(fmt, ...) do { \
-    char buffer[1024]; \
-    snprintf(buffer, sizeof(buffer), fmt, ##__VA_ARGS__); \
-    Logger::debugWithLocation(std::string(buffer), __FILE__, __LINE__, __FUNCTION__); \
+    LOGGER_LOG_IF_ENABLED(LogLevel::FATAL, 4, Logger::fatalWithLocation(msg, __FILE__, __LINE__, __FUNCTION__))
+
+// 支持格式化字符串的宏（printf 风格，格式化到栈上缓冲，不分配内存）
+#define LOGGER_PRINTF_IMPL(level, levelValue, fmt, ...) do { \
+    if ((levelValue) >= LOGGER_MIN_LEVEL && Logger::isEnabled(level)) { \
+        char buffer[1024]; \
+        int length = snprintf(buffer, sizeof(buffer), fmt, ##__VA_ARGS__); \
+        if (length >= 0) { \
+            size_t size = std::min(static_cast<size_t>(length), sizeof(buffer) - 1); \
+            Logger::logMessage(level, std::string_view(buffer, size), __FILE__, __LINE__, __FUNCTION__); \
+        } \
+    } \
 } while(0)
 
-#define LOGGER_INFO_FMT(fmt, ...) do { \
-    char buffer[1024]; \
-    snprintf(buffer, sizeof(buffer), fmt, ##__VA_ARGS__); \
-    Logger::infoWithLocation(std::string(buffer), __FILE__, __LINE__, __FUNCTION__); \
-} while(0)
+#define LOGGER_DEBUG_FMT(fmt, ...) LOGGER_PRINTF_IMPL(LogLevel::DEBUG, 0, fmt, ##__VA_ARGS__)
+#define LOGGER_INFO_FMT(fmt, ...) LOGGER_PRINTF_IMPL(LogLevel::INFO, 1, fmt, ##__VA_ARGS__)
+#define LOGGER_WARNING_FMT(fmt, ...) LOGGER_PRINTF_IMPL(LogLevel::WARNING, 2, fmt, ##__VA_ARGS__)
+#define LOGGER_ERROR_FMT(fmt, ...) LOGGER_PRINTF_IMPL(LogLevel::ERROR, 3, fmt, ##__VA_ARGS__)
+#define LOGGER_FATAL_FMT(fmt, ...) LOGGER_PRINTF_IMPL(LogLevel::FATAL, 4, fmt, ##__VA_ARGS__)
 
-#define LOGGER_WARNING_FMT(fmt, ...) do { \
-    char buffer[1024]; \
-    snprintf(buffer, sizeof(buffer), fmt, ##__VA_ARGS__); \
-    Logger::warningWithLocation(std::string(buffer), __FILE__, __LINE__, __FUNCTION__); \
-} while(0)
+// fmt 风格的格式化宏：LOGGER_INFO_F("Acquired model {} for type {}", index, type)
+// 参数直接追加到线程私有缓冲，不构造临时字符串
+#define LOGGER_DEBUG_F(fmt, ...) \
+    LOGGER_LOG_IF_ENABLED(LogLevel::DEBUG, 0, Logger::logFormat(LogLevel::DEBUG, __FILE__, __LINE__, __FUNCTION__, fmt, ##__VA_ARGS__))
 
-#define LOGGER_ERROR_FMT(fmt, ...) do { \
-    char buffer[1024]; \
-    snprintf(buffer, sizeof(buffer), fmt, ##__VA_ARGS__); \
-    Logger::errorWithLocation(std::string(buffer), __FILE__, __LINE__, __FUNCTION__); \
-} while(0)
+#define LOGGER_INFO_F(fmt, ...) \
+    LOGGER_LOG_IF_ENABLED(LogLevel::INFO, 1, Logger::logFormat(LogLevel::INFO, __FILE__, __LINE__, __FUNCTION__, fmt, ##__VA_ARGS__))
 
-#define LOGGER_FATAL_FMT(fmt, ...) do { \
-    char buffer[1024]; \
-    snprintf(buffer, sizeof(buffer), fmt, ##__VA_ARGS__); \
-    Logger::fatalWithLocation(std::string(buffer), __FILE__, __LINE__, __FUNCTION__); \
-} while(0)
+#define LOGGER_WARNING_F(fmt, ...) \
+    LOGGER_LOG_IF_ENABLED(LogLevel::WARNING, 2, Logger::logFormat(LogLevel::WARNING, __FILE__, __LINE__, __FUNCTION__, fmt, ##__VA_ARGS__))
+
+#define LOGGER_ERROR_F(fmt, ...) \
+    LOGGER_LOG_IF_ENABLED(LogLevel::ERROR, 3, Logger::logFormat(LogLevel::ERROR, __FILE__, __LINE__, __FUNCTION__, fmt, ##__VA_ARGS__))
+
+#define LOGGER_FATAL_F(fmt, ...) \
+    LOGGER_LOG_IF_ENABLED(LogLevel::FATAL, 4, Logger::logFormat(LogLevel::FATAL, __FILE__, __LINE__, __FUNCTION__, fmt, ##__VA_ARGS__))
 
 // 条件日志宏
 #define LOGGER_DEBUG_IF(condition, msg) \
@@ -169,11 +307,11 @@ class FunctionTracker {
 public:
     FunctionTracker(const char* file, int line, const char* function)
             : file_(file), line_(line), function_(function) {
-        Logger::debugWithLocation("Function entered", file_, line_, function_);
+        LOGGER_LOG_IF_ENABLED(LogLevel::DEBUG, 0, Logger::debugWithLocation("Function entered", file_, line_, function_));
     }
 
     ~FunctionTracker() {
-        Logger::debugWithLocation("Function exited", file_, line_, function_);
+        LOGGER_LOG_IF_ENABLED(LogLevel::DEBUG, 0, Logger::debugWithLocation("Function exited", file_, line_, function_));
     }
 
 private:
@@ -23,6 +23,41 @@ struct ModelConfig {
     // 对象检测阈值
     float objectThresh = 0.5;
 
+    // 推理后端："rknn"（NPU）或 "cpu"（CPU参考实现）
+    std::string backend = "rknn";
+
+    // CPU参考后端：模拟推理耗时（毫秒）
+    int cpuLatencyMs = 20;
+
+    // CPU参考后端：每帧生成的检测框数量
+    int cpuDetectionCount = 3;
+
+    // 实例数（0 表示使用全局 model_pool_size）
+    int poolSize = 0;
+
+    // 弹性伸缩的实例数上下限（0 表示使用默认：下限1，上限为实例数）
+    int poolMinInstances = 0;
+    int poolMaxInstances = 0;
+
+    // 动态批处理最大批大小（0 表示使用全局 batch_max_size）
+    int batchSize = 0;
+
+    // 等待实例（或等待凑批）的请求数上限，超出时立即失败（0 表示不限制）
+    int maxQueue = 0;
+
+    // 实例按序号轮流绑定的NPU核心（为空时按模型类型分配）
+    std::vector<int> npuCores;
+
+    // 批处理调度线程绑定的CPU核心（为空时不绑定）
+    std::vector<int> cpuAffinity;
+
+    // 模型输入尺寸（0 表示未知，不做降采样解码）
+    int inputWidth = 0;
+    int inputHeight = 0;
+
+    // 每个关键点的附加数值个数，前两个为 x、y（0 表示附加数值不是坐标，降采样解码后不做换算）
+    int keypointStride = 0;
+
     /**
      * @brief 从JSON创建配置
      * @param j JSON对象
@@ -45,9 +80,17 @@ struct HTTPServerConfig {
     int port;
     int connectionTimeout;
     int readTimeout;
+    int threadPoolSize;         // 连接工作线程数（<=0 时取 general.threadPoolSize）
+    int maxQueuedConnections;   // 等待工作线程的连接上限，超出时直接关闭连接（<=0 不限）
+    bool tcpNoDelay;            // 是否关闭 Nagle 算法
+    int keepAliveMaxCount;      // 单个长连接最多处理的请求数
+    int listenBacklog;          // 监听队列长度
+    long long payloadMaxLength; // 请求体上限（字节，<=0 不限）
 
     HTTPServerConfig() : host("127.0.0.1"), port(9000),
-                         connectionTimeout(5), readTimeout(5) {}
+                         connectionTimeout(5), readTimeout(5), threadPoolSize(0),
+                         maxQueuedConnections(64), tcpNoDelay(true), keepAliveMaxCount(100),
+                         listenBacklog(128), payloadMaxLength(0) {}
 
     static HTTPServerConfig fromJson(const nlohmann::json& j);
     nlohmann::json toJson() const;
@@ -57,8 +100,13 @@ struct HTTPServerConfig {
 struct GRPCServerConfig {
     std::string host;
     int port;
+    std::string compression;    // 默认响应压缩算法：none / deflate / gzip
+    int streamMaxInflight;      // 每条推理流同时处理的帧数
+    int asyncPollThreads;       // 异步服务完成队列轮询线程数
+    int asyncWorkerThreads;     // 异步推理工作线程数（<=0 时取 max_concurrent_requests）
 
-    GRPCServerConfig() : host("127.0.0.1"), port(50051) {}
+    GRPCServerConfig() : host("127.0.0.1"), port(50051), compression("none"), streamMaxInflight(4),
+                         asyncPollThreads(2), asyncWorkerThreads(0) {}
 
     static GRPCServerConfig fromJson(const nlohmann::json& j);
     nlohmann::json toJson() const;
@@ -69,10 +117,26 @@ struct GRPCServerConfig {
  * */
 struct ConcurrencyServerConfig {
     int maxConcurrentRequests = 10;
+    int maxQueuedRequests = 20;
     int modelPoolSize = 3;
     int requestTimeoutMs = 30000;
     int modelAcquireTimeoutMs = 5000;
     bool enableConcurrencyMonitoring = true;
+    int poolSpinIterations = 100;
+    bool poolThreadAffinity = true;
+    int batchMaxSize = 1;        // 动态批处理最大批大小（1表示不启用）
+    int batchMaxWaitMs = 2;      // 凑批最长等待时间（毫秒）
+    bool poolAutoscale = false;          // 模型池弹性伸缩
+    int poolScaleUpWaitMs = 20;          // 获取等待p95超过该值时扩容（毫秒）
+    int poolScaleDownIdleMs = 60000;     // 实例持续多余该时长后回收（毫秒）
+    int poolScaleIntervalMs = 1000;      // 伸缩评估周期（毫秒）
+    int poolTrimIdleMs = 60000;          // 实例空闲超过该时长后回收工作集内存（毫秒，0 不回收）
+    int framePoolMaxCachedMb = 256;      // 解码缓冲池空闲缓存上限（MB，0 不缓存）
+    std::map<std::string, int> framePoolPreallocate;  // 启动时预分配的解码缓冲区，键为 "宽x高"
+    bool pipelineEnabled = false;        // 分阶段推理流水线（解码/推理/序列化）
+    int pipelineDecodeThreads = 0;       // 解码线程数（0 表示CPU核数的一半）
+    int pipelineSerializeThreads = 2;    // 序列化线程数
+    int pipelineQueueDepth = 64;         // 每个阶段的队列容量
 
     ConcurrencyServerConfig() = default;
 
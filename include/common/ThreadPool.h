@@ -0,0 +1,156 @@
+//
+// Created by YJK on 2026/10/16.
+//
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief 固定线程数的任务线程池
+ * 线程数不随任务数增长；trySubmit 在空闲线程之外的排队任务数达到上限时拒绝，submit 不受上限约束
+ * （供调用方自行限流的场景）；shutdown 时执行完已提交的任务后再退出
+ */
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    static constexpr size_t UNBOUNDED = std::numeric_limits<size_t>::max();
+
+    /**
+     * @brief trySubmit 的结果
+     */
+    enum class SubmitResult {
+        OK,
+        QUEUE_FULL,     // 排队任务数已达上限
+        STOPPED         // 线程池已关闭
+    };
+
+    /**
+     * @brief 构造函数
+     * @param threadCount 工作线程数（至少为1）
+     * @param maxQueued trySubmit 允许的排队任务数（不含立即被空闲线程取走的任务）
+     */
+    explicit ThreadPool(size_t threadCount, size_t maxQueued = UNBOUNDED)
+            : maxQueued_(maxQueued) {
+        if (threadCount == 0) {
+            threadCount = 1;
+        }
+        workers_.reserve(threadCount);
+        for (size_t i = 0; i < threadCount; ++i) {
+            workers_.emplace_back(&ThreadPool::workerLoop, this);
+        }
+    }
+
+    ~ThreadPool() {
+        shutdown();
+    }
+
+    // 禁止拷贝
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief 提交任务
+     * @return 线程池已关闭时返回false，任务不会执行
+     */
+    bool submit(Task task) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stopping_) {
+                return false;
+            }
+            tasks_.push_back(std::move(task));
+        }
+        condition_.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief 提交任务，没有空闲线程且排队任务数已达上限时拒绝
+     */
+    SubmitResult trySubmit(Task task) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stopping_) {
+                return SubmitResult::STOPPED;
+            }
+            if (tasks_.size() >= idleWorkers_ && tasks_.size() - idleWorkers_ >= maxQueued_) {
+                return SubmitResult::QUEUE_FULL;
+            }
+            tasks_.push_back(std::move(task));
+        }
+        condition_.notify_one();
+        return SubmitResult::OK;
+    }
+
+    /**
+     * @brief 停止接收新任务，执行完队列中的任务后等待所有线程退出
+     */
+    void shutdown() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stopping_ && workers_.empty()) {
+                return;
+            }
+            stopping_ = true;
+        }
+        condition_.notify_all();
+
+        for (auto& worker : workers_) {
+            if (worker.joinable()) {
+                worker.join();
+            }
+        }
+        workers_.clear();
+    }
+
+    size_t threadCount() const {
+        return workers_.size();
+    }
+
+    /**
+     * @brief 排队等待执行的任务数
+     */
+    size_t pendingTasks() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return tasks_.size();
+    }
+
+private:
+    void workerLoop() {
+        while (true) {
+            Task task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                ++idleWorkers_;
+                condition_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+                --idleWorkers_;
+                if (tasks_.empty()) {
+                    return;
+                }
+                task = std::move(tasks_.front());
+                tasks_.pop_front();
+            }
+            task();
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::deque<Task> tasks_;
+    mutable std::mutex mutex_;
+    std::condition_variable condition_;
+    const size_t maxQueued_;
+    size_t idleWorkers_ = 0;    // 正在等待任务的线程
+    bool stopping_ = false;
+};
+
+#endif // THREAD_POOL_H
@@ -7,6 +7,8 @@
 #define BASE64_H_C0CE2A47_D10E_42C9_A27C_C883944E704A
 
 #include <string>
+#include <vector>
+#include <cstddef>
 
 #if __cplusplus >= 201703L
 #include <string_view>
@@ -30,6 +32,22 @@ std::string base64_encode_pem (std::string_view s);
 std::string base64_encode_mime(std::string_view s);
 
 std::string base64_decode(std::string_view s, bool remove_linebreaks = false);
+
+//
+// Zero-copy decoding (local addition, not part of the upstream library)
+//
+// 解码结果的最大字节数（用于预分配缓冲区）
+size_t base64_decoded_max_size(size_t encoded_length);
+
+// 解码到调用方提供的缓冲区，返回实际写入的字节数
+// capacity 不足 base64_decoded_max_size(s.size()) 或输入非法时抛出 std::runtime_error
+size_t base64_decode_into(std::string_view s, unsigned char* out, size_t capacity);
+
+// 解码到可复用的缓冲区：只在容量不足时扩容，结束后 out.size() 为实际字节数
+size_t base64_decode_into(std::string_view s, std::vector<unsigned char>& out);
+
+// 当前线程的复用解码缓冲区（内容在下一次使用前有效）
+std::vector<unsigned char>& base64_thread_buffer();
 #endif  // __cplusplus >= 201703L
 
 #endif /* BASE64_H_C0CE2A47_D10E_42C9_A27C_C883944E704A */
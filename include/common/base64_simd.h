@@ -0,0 +1,46 @@
+//
+// Created by YJK on 2026/10/16.
+//
+
+#ifndef BASE64_SIMD_H
+#define BASE64_SIMD_H
+
+#include <cstddef>
+
+/**
+ * @brief base64 向量化编解码（供 base64.cpp 内部使用）
+ * 运行时按CPU特性选择 AVX2 / SSE4.1（x86）或 NEON（aarch64）实现，
+ * 只处理完整的数据块；剩余部分、填充字符、URL字母表和非法字符交给标量实现
+ */
+namespace base64_simd {
+
+    /**
+     * @brief 当前CPU选用的实现名称
+     * @return "avx2"、"sse4.1"、"neon" 或 "scalar"
+     */
+    const char* implementationName();
+
+    /**
+     * @brief 解码尽可能多的完整块，遇到标准字母表以外的字符时停止
+     * @param in 输入字符
+     * @param length 输入长度
+     * @param out 输出缓冲区，容量不小于 (length + 3) / 4 * 3
+     * @param consumed 已处理的输入字符数（4的倍数）
+     * @return 写入的字节数
+     */
+    size_t decode(const char* in, size_t length, unsigned char* out, size_t& consumed);
+
+    /**
+     * @brief 编码尽可能多的完整块
+     * @param in 输入字节
+     * @param length 输入长度
+     * @param out 输出缓冲区，容量不小于 (length + 2) / 3 * 4
+     * @param url 是否使用URL字母表（'-' 和 '_'）
+     * @param consumed 已处理的输入字节数（3的倍数）
+     * @return 写入的字符数
+     */
+    size_t encode(const unsigned char* in, size_t length, char* out, bool url, size_t& consumed);
+
+} // namespace base64_simd
+
+#endif // BASE64_SIMD_H
@@ -11,6 +11,7 @@
 #include <cmath>
 #include <vector>
 #include <algorithm>
+#include <thread>
 #include "nlohmann/json.hpp"
 
 using json = nlohmann::json;
@@ -29,4 +30,12 @@ double getGaugeReading(const std::vector<int>& poseCls, const std::vector<std::v
 
 json any_to_json(const std::any& value);
 
+/**
+ * @brief 将线程绑定到指定CPU核心（仅Linux有效，其他平台返回false）
+ * @param thread 目标线程
+ * @param cpus CPU核心序号
+ * @return 是否绑定成功
+ */
+bool setThreadAffinity(std::thread& thread, const std::vector<int>& cpus);
+
 #endif //FFMPEG_PULL_PUSH_UTILS_H
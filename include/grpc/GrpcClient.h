@@ -5,7 +5,9 @@
 #ifndef GRPC_CLIENT_H
 #define GRPC_CLIENT_H
 
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 #include <grpcpp/grpcpp.h>
@@ -15,15 +17,50 @@
 
 class GrpcClient {
 public:
+    /**
+     * @brief 推理流会话（ProcessImageStream）
+     * 一条流上连续发送原始图像帧；send 与 read 可在不同线程中同时调用，
+     * 结果按 frame_id 对应，可能与发送顺序不同
+     */
+    class ImageStream {
+    public:
+        // 发送一帧原始图像（JPEG/PNG等）
+        bool send(uint64_t frame_id,
+                  const std::string& image,
+                  int model_type,
+                  int priority = 0,
+                  int deadline_ms = 0);
+
+        // 阻塞读取下一帧结果，流结束时返回false
+        bool read(grpc_service::FrameResult& result);
+
+        // 结束发送并等待流关闭（需先读完所有结果）
+        bool finish(std::string& error_message);
+
+    private:
+        friend class GrpcClient;
+        ImageStream() = default;
+
+        grpc::ClientContext context_;
+        std::unique_ptr<grpc::ClientReaderWriter<grpc_service::ImageFrame, grpc_service::FrameResult>> stream_;
+        std::mutex write_mutex_;
+        bool writes_done_ = false;
+    };
+
     // 使用服务器地址初始化客户端
     explicit GrpcClient(const std::string& server_address);
 
-    // 使用AI模型处理图像
+    // 使用AI模型处理图像（priority 越大越优先，deadline_ms 为请求剩余时间，0表示不限制）
     bool processImage(const std::string& base64_image,
                       int model_type,
                       std::vector<std::vector<float>>& detection_results,
                       std::vector<std::string>& plate_results,
-                      std::string& error_message);
+                      std::string& error_message,
+                      int priority = 0,
+                      int deadline_ms = 0);
+
+    // 打开推理流，用于摄像头等连续帧场景，避免每帧的调用开销与base64编码
+    std::unique_ptr<ImageStream> openImageStream();
 
     // 控制模型状态（启用/禁用）
     bool controlModel(const std::string& model_name,
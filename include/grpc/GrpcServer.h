@@ -6,12 +6,16 @@
 #include <string>
 #include <vector>
 #include <mutex>
+#include <thread>
 #include <unordered_map>
 #include <grpcpp/grpcpp.h>
+#include "grpc/base/GrpcAsyncService.h"
 
 class GrpcServer {
 public:
-    explicit GrpcServer(const std::string& server_address);
+    explicit GrpcServer(const std::string& server_address,
+                        grpc_compression_algorithm compression = GRPC_COMPRESS_NONE,
+                        int async_poll_threads = 2);
     ~GrpcServer();
 
     // 向服务器注册gRPC服务
@@ -32,6 +36,18 @@ public:
         return true;
     }
 
+    // 注册含异步方法的服务：服务器为其创建完成队列并在启动后开始轮询
+    template <typename ServiceImpl>
+    bool registerAsyncService(std::shared_ptr<ServiceImpl> service) {
+        if (!registerService(service)) {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(server_mutex_);
+        async_services_.push_back(service);
+        return true;
+    }
+
     // 启动gRPC服务器
     bool start();
 
@@ -41,7 +57,13 @@ public:
     // 检查服务器是否运行中
     bool isRunning() const;
 
+    // 将配置中的压缩算法名称（none/deflate/gzip）转换为gRPC枚举，未知名称按none处理
+    static grpc_compression_algorithm compressionFromString(const std::string& name);
+
 private:
+    // 完成队列轮询线程：取出事件并交给对应的异步调用处理
+    static void pollCompletionQueue(grpc::ServerCompletionQueue* queue);
+
     std::string server_address_;
     std::unique_ptr<grpc::Server> server_;
     grpc::ServerBuilder builder_;
@@ -50,6 +72,12 @@ private:
     // 服务容器（使用void进行类型擦除）
     std::vector<std::shared_ptr<void>> services_;
 
+    // 异步服务、完成队列（每个队列一个轮询线程）
+    std::vector<std::shared_ptr<GrpcAsyncService>> async_services_;
+    std::vector<std::unique_ptr<grpc::ServerCompletionQueue>> completion_queues_;
+    std::vector<std::thread> poll_threads_;
+    int async_poll_threads_;
+
     // 用于线程安全的互斥锁
     mutable std::mutex server_mutex_;
 };
@@ -0,0 +1,46 @@
+//
+// Created by YJK on 2026/10/16.
+//
+
+#ifndef GRPC_ASYNC_SERVICE_H
+#define GRPC_ASYNC_SERVICE_H
+
+#include <vector>
+#include <grpcpp/grpcpp.h>
+
+/**
+ * @brief 完成队列上的异步调用标签
+ * GrpcServer 的轮询线程从完成队列取出事件后调用 proceed 推进调用状态
+ */
+class GrpcAsyncCall {
+public:
+    virtual ~GrpcAsyncCall() = default;
+
+    /**
+     * @brief 处理一次完成队列事件
+     * @param ok 事件是否成功（服务器关闭时为false）
+     */
+    virtual void proceed(bool ok) = 0;
+};
+
+/**
+ * @brief 含异步方法的服务需实现的接口
+ * 通过 GrpcServer::registerAsyncService 注册，由服务器统一管理完成队列与轮询线程
+ */
+class GrpcAsyncService {
+public:
+    virtual ~GrpcAsyncService() = default;
+
+    /**
+     * @brief 服务器启动后调用，在各完成队列上挂起首批待接收的调用
+     * @param queues 服务器持有的完成队列
+     */
+    virtual void startAsync(const std::vector<grpc::ServerCompletionQueue*>& queues) = 0;
+
+    /**
+     * @brief 服务器 Shutdown 之后、完成队列关闭之前调用，需确保所有调用都已提交 Finish
+     */
+    virtual void stopAsync() = 0;
+};
+
+#endif // GRPC_ASYNC_SERVICE_H
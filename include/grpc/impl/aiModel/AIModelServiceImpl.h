@@ -5,26 +5,92 @@
 #ifndef AI_MODEL_SERVICE_IMPL_H
 #define AI_MODEL_SERVICE_IMPL_H
 
+#include <atomic>
+#include <memory>
+#include <vector>
 #include <grpcpp/grpcpp.h>
 #include "grpc/message/grpc_service.grpc.pb.h"
+#include "grpc/base/GrpcAsyncService.h"
+#include "common/ThreadPool.h"
+#include "AIService/engine/InferenceEngine.h"
 
 // Forward declaration
 class ApplicationManager;
 
-class AIModelServiceImpl final : public grpc_service::AIModelService::Service {
+/**
+ * @brief AI模型服务
+ * ProcessImage 为异步方法：完成队列轮询线程只负责收发，模型获取与推理在固定大小的工作线程池中执行，
+ * 未完成的调用只占用队列中的任务而不占用线程；ProcessImageStream 与 ControlModel 仍为同步方法，
+ * 其中流式调用的各帧同样提交到该工作线程池处理
+ */
+class AIModelServiceImpl final
+        : public grpc_service::AIModelService::WithAsyncMethod_ProcessImage<grpc_service::AIModelService::Service>,
+          public GrpcAsyncService {
 public:
     explicit AIModelServiceImpl(ApplicationManager& appManager);
 
-    grpc::Status ProcessImage(grpc::ServerContext* context,
-                              const grpc_service::ImageRequest* request,
-                              grpc_service::ImageResponse* response) override;
+    void startAsync(const std::vector<grpc::ServerCompletionQueue*>& queues) override;
+
+    void stopAsync() override;
+
+    grpc::Status ProcessImageStream(grpc::ServerContext* context,
+                                    grpc::ServerReaderWriter<grpc_service::FrameResult,
+                                            grpc_service::ImageFrame>* stream) override;
 
     grpc::Status ControlModel(grpc::ServerContext* context,
                               const grpc_service::ModelControlRequest* request,
                               grpc_service::ModelControlResponse* response) override;
 
 private:
+    class ProcessImageCall;
+
+    /**
+     * @brief 处理一次 ProcessImage 调用（在工作线程中执行）
+     */
+    grpc::Status handleProcessImage(grpc::ServerContext* context,
+                                    const grpc_service::ImageRequest* request,
+                                    grpc_service::ImageResponse* response);
+
+    /**
+     * @brief 请求剩余时间（毫秒）：取调用的deadline与 requestDeadlineMs 中较早者，均未设置时为0
+     * 流式调用中每一帧都以整条流的deadline为上限
+     */
+    static int remainingBudgetMs(const grpc::ServerContext* context, int requestDeadlineMs);
+
+    /**
+     * @brief 单张图像的完整处理流程（准入、解码、推理、填充响应），供单次调用与流式调用共用
+     * @param payload 图像数据
+     * @param isBase64 payload 是否为base64文本
+     * @param modelType 模型类型
+     * @param priority 调度优先级
+     * @param budgetMs 请求剩余时间（毫秒），0表示使用 request_timeout_ms
+     * @param response 响应
+     * @return 准入或截止时间失败时返回对应的错误状态，其余情况为OK（结果见 response->success()）
+     */
+    grpc::Status processEncodedImage(const std::string& payload,
+                                     bool isBase64,
+                                     int modelType,
+                                     int priority,
+                                     int budgetMs,
+                                     grpc_service::ImageResponse* response);
+
+    /**
+     * @brief 按推理结果填充响应
+     */
+    static void fillImageResponse(const InferenceOutput& output,
+                                  long long processingMs,
+                                  grpc_service::ImageResponse* response);
+
+    /**
+     * @brief 推理失败时按模型池状态给出诊断信息
+     */
+    std::string inferenceFailureDetail(int modelType, int timeoutMs) const;
+
     ApplicationManager& appManager_;
+
+    // 异步调用与流式调用共用的推理工作线程池
+    std::unique_ptr<ThreadPool> workerPool_;
+    std::atomic<bool> shuttingDown_{false};
 };
 
 #endif // AI_MODEL_SERVICE_IMPL_H
\ No newline at end of file
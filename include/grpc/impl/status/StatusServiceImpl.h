@@ -64,6 +64,14 @@ private:
     void fillConcurrencyStats(const ConcurrencyMonitor::Stats& stats,
                               grpc_service::ConcurrencyStats* grpcStats);
 
+    /**
+     * @brief 填充各阶段延迟分布
+     * @param latencies 源统计数据
+     * @param grpcStats 目标gRPC消息
+     */
+    void fillLatencyStats(const std::vector<ConcurrencyMonitor::LatencyStats>& latencies,
+                          grpc_service::ConcurrencyStats* grpcStats);
+
     /**
      * @brief 辅助方法：填充模型池信息
      * @param modelType 模型类型
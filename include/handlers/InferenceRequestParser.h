@@ -0,0 +1,56 @@
+//
+// Created by YJK on 2026/10/16.
+//
+
+#ifndef INFERENCE_REQUEST_PARSER_H
+#define INFERENCE_REQUEST_PARSER_H
+
+#include <string>
+#include <string_view>
+
+namespace Handlers {
+
+    /**
+     * @brief 推理请求体中的字段
+     * image 指向请求体内 img 字符串的原始字节，不做拷贝；
+     * 仅当 img 含转义字符时才退化为保存在 imageStorage 中的反转义副本
+     */
+    struct InferenceRequest {
+        bool hasImage = false;          // 是否包含 img 字段
+        bool imageIsString = false;     // img 是否为字符串
+        std::string_view image;         // img 内容（引用请求体或 imageStorage）
+        std::string imageStorage;       // 含转义字符时的副本
+
+        bool hasModelType = false;
+        bool modelTypeIsNumber = false;
+        int modelType = 0;
+
+        bool hasTimeout = false;
+        int timeout = 0;
+
+        bool hasStartValue = false;
+        double startValue = 0.0;
+
+        bool hasEndValue = false;
+        double endValue = 0.0;
+
+        bool hasPriority = false;
+        int priority = 0;
+
+        bool hasDeadlineMs = false;
+        int deadlineMs = 0;
+    };
+
+    /**
+     * @brief 基于 SAX 解析推理请求，不构建JSON DOM
+     * 只提取顶层标量字段，img 字符串在词法分析阶段被整体跳过，仅记录其在请求体中的位置
+     * @param body 请求体，解析结果中的 image 在 body 生命周期内有效
+     * @param request 解析结果
+     * @param error 解析失败时的错误信息
+     * @return 是否为合法的JSON
+     */
+    bool parseInferenceRequest(const std::string& body, InferenceRequest& request, std::string& error);
+
+} // namespace Handlers
+
+#endif // INFERENCE_REQUEST_PARSER_H
@@ -9,6 +9,13 @@
 
 namespace Handlers {
     void handle_api_model_process(const httplib::Request& req, httplib::Response& res);
+
+    /**
+     * @brief 二进制图像推理接口
+     * 请求体为原始图像（image/<type>、application/octet-stream）或 multipart/form-data 中的 image 文件，
+     * modelType 等参数通过查询参数、表单字段或 X-* 请求头传递
+     */
+    void handle_api_model_process_binary(const httplib::Request& req, httplib::Response& res);
 }
 
 #endif //HTTP_MODEL_API_HANDLER_H
@@ -0,0 +1,19 @@
+//
+// Created by YJK on 2026/10/16.
+//
+
+#ifndef METRICS_HANDLER_H
+#define METRICS_HANDLER_H
+
+#include "httplib.h"
+
+namespace Handlers {
+    /**
+     * @brief Prometheus 文本格式（0.0.4）的指标导出
+     * 包含模型池、批处理、准入控制、请求并发、各阶段延迟与日志丢弃计数；
+     * 只读取原子计数器，模型池表只取共享锁
+     */
+    void handle_metrics(const httplib::Request& req, httplib::Response& res);
+}
+
+#endif // METRICS_HANDLER_H
@@ -8,6 +8,7 @@
 #include "httplib.h"
 #include "common/StreamConfig.h"
 #include "common/Logger.h"
+#include "routeManager/HttpTaskQueue.h"
 #include <string>
 #include <functional>
 #include <vector>
@@ -47,7 +48,27 @@ private:
     std::unique_ptr<std::thread> serverThread;
     std::atomic<bool> serverStarted{false};
 
+    // 连接任务队列的计数器
+    std::shared_ptr<HttpTaskQueue::Counters> connectionCounters;
+
+    /**
+     * @brief 按配置设置线程池、TCP选项、长连接与请求体上限
+     */
+    void applyConnectionOptions();
+
 public:
+    /**
+     * @brief 连接处理统计
+     */
+    struct ConnectionStats {
+        size_t threads = 0;
+        size_t busy = 0;
+        size_t queued = 0;
+        size_t maxQueued = 0;
+        uint64_t accepted = 0;
+        uint64_t rejected = 0;
+    };
+
     /**
      * @brief 构造函数
      * @param serverConfig HTTP服务器配置
@@ -152,6 +173,11 @@ public:
      */
     const std::vector<RouteInfo>& getRoutes() const;
 
+    /**
+     * @brief 获取连接处理统计
+     */
+    ConnectionStats getConnectionStats() const;
+
     /**
      * @brief 等待服务器线程结束
      */
@@ -0,0 +1,58 @@
+//
+// Created by YJK on 2026/10/16.
+//
+
+#ifndef HTTP_TASK_QUEUE_H
+#define HTTP_TASK_QUEUE_H
+
+#include "httplib.h"
+#include "common/BoundedQueue.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief HTTP连接任务队列
+ * 替换 httplib 默认的线程池：工作线程数由配置决定，等待队列有上限；
+ * 队列满时 enqueue 返回 false，由 httplib 直接关闭连接，不读取请求
+ */
+class HttpTaskQueue : public httplib::TaskQueue {
+public:
+    /**
+     * @brief 计数器，由 HttpServer 持有，任务队列随 listen 结束销毁后仍可读取
+     */
+    struct Counters {
+        std::atomic<size_t> threads{0};
+        std::atomic<size_t> busy{0};            // 正在处理连接的工作线程
+        std::atomic<size_t> queued{0};          // 等待工作线程的连接
+        std::atomic<size_t> maxQueued{0};
+        std::atomic<uint64_t> accepted{0};      // 交给工作线程的连接
+        std::atomic<uint64_t> rejected{0};      // 等待队列已满而直接关闭的连接
+    };
+
+    /**
+     * @brief 构造函数
+     * @param threadCount 工作线程数（至少为1）
+     * @param maxQueued 等待队列上限，0 表示不限
+     * @param counters 计数器
+     */
+    HttpTaskQueue(size_t threadCount, size_t maxQueued, std::shared_ptr<Counters> counters);
+
+    ~HttpTaskQueue() override;
+
+    bool enqueue(std::function<void()> fn) override;
+
+    void shutdown() override;
+
+private:
+    void workerLoop();
+
+    std::shared_ptr<Counters> counters_;
+    BoundedQueue<std::function<void()>> queue_;
+    std::vector<std::thread> workers_;
+};
+
+#endif // HTTP_TASK_QUEUE_H
@@ -11,6 +11,7 @@
 #include "routeManager/route/ApiRoutes.h"
 #include "routeManager/route/ModelRoutes.h"
 #include "routeManager/route/StatusRoutes.h"
+#include "routeManager/route/MetricsRoutes.h"
 
 /**
  * @brief 路由初始化器
@@ -39,6 +40,9 @@ public:
         // 注册状态路由
         routeManager.addGroup(std::make_shared<StatusRoutes>());
 
+        // 注册指标导出路由
+        routeManager.addGroup(std::make_shared<MetricsRoutes>());
+
         // 可以在这里添加更多路由组
         // 例如:
         // routeManager.addGroup(std::make_shared<AdminRoutes>());
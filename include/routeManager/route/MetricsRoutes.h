@@ -0,0 +1,24 @@
+//
+// Created by YJK on 2026/10/16.
+//
+
+#ifndef METRICS_ROUTES_H
+#define METRICS_ROUTES_H
+
+#include "routeManager/RouteManager.h"
+#include "handlers/metrics_handler.h"
+
+/**
+ * @brief 指标导出路由组
+ * 供 Prometheus 等采集端抓取
+ */
+class MetricsRoutes : public BaseRouteGroup {
+public:
+    MetricsRoutes() : BaseRouteGroup("metrics", "/metrics", "Prometheus 指标导出接口") {}
+
+    void registerRoutes(HttpServer& server) override {
+        server.addGet("/metrics", Handlers::handle_metrics, "Prometheus 指标");
+    }
+};
+
+#endif // METRICS_ROUTES_H
@@ -21,6 +21,9 @@ public:
         server.addGet("/api/model/inference", Handlers::handle_api_model_process, "模型推理")
                 .addPost("/api/model/inference", Handlers::handle_api_model_process, "模型推理");
 
+        // 二进制图像推理接口（免Base64编码）
+        server.addPost("/api/model/inference/binary", Handlers::handle_api_model_process_binary, "模型推理（二进制图像）");
+
         // 这里可以添加更多模型相关接口
     }
 };
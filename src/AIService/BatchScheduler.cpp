@@ -0,0 +1,246 @@
+//
+// Created by YJK on 2026/10/16.
+//
+
+#include "AIService/BatchScheduler.h"
+#include "common/utils.h"
+#include <algorithm>
+#include <limits>
+
+BatchScheduler::BatchScheduler(ModelPool& pool, size_t maxBatchSize, int maxWaitMs, size_t maxQueue)
+        : pool_(pool),
+          maxBatchSize_(std::max<size_t>(1, maxBatchSize)),
+          maxWait_(std::max(0, maxWaitMs)),
+          maxQueue_(maxQueue) {}
+
+BatchScheduler::~BatchScheduler() {
+    stop();
+}
+
+void BatchScheduler::start(size_t workerCount, const std::vector<int>& cpuAffinity) {
+    if (running_.exchange(true)) {
+        return;
+    }
+
+    workerCount = std::max<size_t>(1, workerCount);
+    workers_.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; ++i) {
+        workers_.emplace_back(&BatchScheduler::workerLoop, this);
+        if (!cpuAffinity.empty() && !setThreadAffinity(workers_.back(), cpuAffinity)) {
+            LOGGER_WARNING("Failed to set CPU affinity for batch scheduler worker " + std::to_string(i));
+        }
+    }
+
+    LOGGER_INFO("Batch scheduler started with " + std::to_string(workerCount) +
+                 " workers, max batch size: " + std::to_string(maxBatchSize_) +
+                 ", max wait: " + std::to_string(maxWait_.count()) + "ms" +
+                 (maxQueue_ > 0 ? ", max queue: " + std::to_string(maxQueue_) : std::string()) +
+                 (cpuAffinity.empty() ? std::string() : ", pinned to " + std::to_string(cpuAffinity.size()) + " cpus"));
+}
+
+void BatchScheduler::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        queueCondition_.notify_all();
+    }
+
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    workers_.clear();
+
+    // 未处理的请求以失败返回
+    std::deque<std::shared_ptr<BatchItem>> pending;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        pending.swap(queue_);
+    }
+    for (auto& item : pending) {
+        item->done.set_value(false);
+    }
+
+    LOGGER_INFO("Batch scheduler stopped, total batches: " + std::to_string(totalBatches_.load()) +
+                 ", total batched requests: " + std::to_string(totalBatchedRequests_.load()));
+}
+
+bool BatchScheduler::submit(const cv::Mat& image, const InferenceParams& params, InferenceOutput& output, int timeoutMs,
+                            const AcquirePriority& priority, StageTimings* timings) {
+    auto item = std::make_shared<BatchItem>();
+    item->image = image;
+    item->params = params;
+    item->priority = priority.priority;
+    item->enqueueTime = std::chrono::steady_clock::now();
+    item->deadline = std::min(item->enqueueTime + std::chrono::milliseconds(timeoutMs), priority.deadline);
+
+    auto future = item->done.get_future();
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        if (!running_.load()) {
+            return false;
+        }
+        if (maxQueue_ > 0 && queue_.size() >= maxQueue_) {
+            rejectedRequests_++;
+            return false;
+        }
+        queue_.push_back(item);
+
+        // 凑满一批或首个请求到达时唤醒调度线程
+        if (queue_.size() >= maxBatchSize_ || queue_.size() == 1) {
+            queueCondition_.notify_one();
+        }
+    }
+
+    if (!future.get()) {
+        return false;
+    }
+
+    output = std::move(item->output);
+    if (timings) {
+        timings->set(LatencyStage::POOL_WAIT, item->enqueueTime, item->inferenceStart);
+        timings->set(LatencyStage::INFERENCE, item->inferenceStart, item->inferenceEnd);
+    }
+    return true;
+}
+
+void BatchScheduler::workerLoop() {
+    std::vector<std::shared_ptr<BatchItem>> batch;
+    batch.reserve(maxBatchSize_);
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(queueMutex_);
+
+            queueCondition_.wait(lock, [this] {
+                return !running_.load() || !queue_.empty();
+            });
+
+            if (!running_.load()) {
+                return;
+            }
+
+            // 等待凑满一批，或最早的请求等待时间达到上限
+            auto flushTime = queue_.front()->enqueueTime + maxWait_;
+            while (running_.load() && !queue_.empty() && queue_.size() < maxBatchSize_ &&
+                   std::chrono::steady_clock::now() < flushTime) {
+                queueCondition_.wait_until(lock, flushTime);
+                if (!queue_.empty()) {
+                    flushTime = queue_.front()->enqueueTime + maxWait_;
+                }
+            }
+
+            if (!running_.load()) {
+                return;
+            }
+            if (queue_.empty()) {
+                continue; // 已被其他调度线程取走
+            }
+
+            size_t count = std::min(maxBatchSize_, queue_.size());
+            for (size_t i = 0; i < count; ++i) {
+                batch.push_back(std::move(queue_.front()));
+                queue_.pop_front();
+            }
+
+            // 还有剩余请求时交给其他调度线程
+            if (!queue_.empty()) {
+                queueCondition_.notify_one();
+            }
+        }
+
+        runBatch(batch);
+        batch.clear();
+    }
+}
+
+void BatchScheduler::runBatch(std::vector<std::shared_ptr<BatchItem>>& batch) {
+    auto now = std::chrono::steady_clock::now();
+
+    // 丢弃已超时的请求
+    AcquirePriority batchPriority;
+    batchPriority.priority = std::numeric_limits<int>::min();
+    size_t live = 0;
+    for (auto& item : batch) {
+        if (item->deadline <= now) {
+            item->done.set_value(false);
+            continue;
+        }
+        batchPriority.priority = std::max(batchPriority.priority, item->priority);
+        batchPriority.deadline = std::min(batchPriority.deadline, item->deadline);
+        batch[live++] = std::move(item);
+    }
+    batch.resize(live);
+
+    if (batch.empty()) {
+        return;
+    }
+
+    int timeoutMs = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            batchPriority.deadline - now).count());
+
+    ModelAcquirer acquirer(pool_, std::max(1, timeoutMs), batchPriority);
+    if (!acquirer.isValid()) {
+        LOGGER_WARNING("Batch scheduler failed to acquire model for batch of " + std::to_string(batch.size()));
+        for (auto& item : batch) {
+            item->done.set_value(false);
+        }
+        return;
+    }
+
+    std::vector<cv::Mat> images;
+    std::vector<InferenceParams> params;
+    std::vector<InferenceOutput> outputs(batch.size());
+    std::vector<char> success(batch.size(), 0);
+    images.reserve(batch.size());
+    params.reserve(batch.size());
+    for (auto& item : batch) {
+        images.push_back(item->image);
+        params.push_back(item->params);
+    }
+
+    auto inferenceStart = std::chrono::steady_clock::now();
+    try {
+        acquirer->inferBatch(images, params, outputs, success);
+    } catch (const std::exception& e) {
+        LOGGER_ERROR("Batch inference failed: " + std::string(e.what()));
+        std::fill(success.begin(), success.end(), 0);
+    }
+
+    auto inferenceEnd = std::chrono::steady_clock::now();
+
+    totalBatches_++;
+    totalBatchedRequests_ += batch.size();
+
+    for (size_t i = 0; i < batch.size(); ++i) {
+        batch[i]->inferenceStart = inferenceStart;
+        batch[i]->inferenceEnd = inferenceEnd;
+        if (success[i]) {
+            batch[i]->output = std::move(outputs[i]);
+        }
+        batch[i]->done.set_value(success[i] != 0);
+    }
+}
+
+BatchScheduler::Stats BatchScheduler::getStats() const {
+    Stats stats;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        stats.queuedRequests = queue_.size();
+    }
+    stats.totalBatches = totalBatches_.load();
+    stats.totalBatchedRequests = totalBatchedRequests_.load();
+    stats.averageBatchSize = stats.totalBatches > 0
+                             ? static_cast<double>(stats.totalBatchedRequests) / stats.totalBatches
+                             : 0.0;
+    stats.maxBatchSize = maxBatchSize_;
+    stats.maxWaitMs = static_cast<int>(maxWait_.count());
+    stats.maxQueue = maxQueue_;
+    stats.rejectedRequests = rejectedRequests_.load();
+    return stats;
+}
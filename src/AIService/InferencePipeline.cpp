@@ -0,0 +1,280 @@
+//
+// Created by YJK on 2026/10/16.
+//
+
+#include "AIService/InferencePipeline.h"
+#include "common/Logger.h"
+#include "common/utils.h"
+#include <algorithm>
+#include <chrono>
+
+InferencePipeline::InferencePipeline(const Options& options, InferFunction infer)
+        : options_(options),
+          infer_(std::move(infer)),
+          decodeQueue_(options.queueDepth),
+          serializeQueue_(options.queueDepth) {
+    options_.decodeThreads = std::max<size_t>(1, options_.decodeThreads);
+    options_.serializeThreads = std::max<size_t>(1, options_.serializeThreads);
+}
+
+InferencePipeline::~InferencePipeline() {
+    stop();
+}
+
+void InferencePipeline::addModel(int modelType, size_t workerCount, const std::vector<int>& cpuAffinity) {
+    if (running_.load()) {
+        LOGGER_WARNING("Cannot add model type " + std::to_string(modelType) + " to a running pipeline");
+        return;
+    }
+    models_[modelType] = std::make_unique<ModelStage>(modelType, std::max<size_t>(1, workerCount),
+                                                      cpuAffinity, options_.queueDepth);
+}
+
+void InferencePipeline::start() {
+    if (running_.exchange(true)) {
+        return;
+    }
+
+    for (size_t i = 0; i < options_.decodeThreads; ++i) {
+        decodeWorkers_.emplace_back(&InferencePipeline::decodeLoop, this);
+    }
+    for (auto& pair : models_) {
+        ModelStage& stage = *pair.second;
+        for (size_t i = 0; i < stage.workerCount; ++i) {
+            stage.workers.emplace_back(&InferencePipeline::inferenceLoop, this, std::ref(stage));
+            if (!stage.cpuAffinity.empty() && !setThreadAffinity(stage.workers.back(), stage.cpuAffinity)) {
+                LOGGER_WARNING("Failed to set CPU affinity for pipeline inference worker " + std::to_string(i) +
+                                " of model type " + std::to_string(stage.modelType));
+            }
+        }
+    }
+    for (size_t i = 0; i < options_.serializeThreads; ++i) {
+        serializeWorkers_.emplace_back(&InferencePipeline::serializeLoop, this);
+    }
+
+    LOGGER_INFO("Inference pipeline started - decode threads: " + std::to_string(options_.decodeThreads) +
+                 ", model stages: " + std::to_string(models_.size()) +
+                 ", serialize threads: " + std::to_string(options_.serializeThreads) +
+                 ", queue depth: " + std::to_string(options_.queueDepth));
+}
+
+void InferencePipeline::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+
+    // 按阶段顺序关闭：上游线程全部退出后再关闭下游队列，已入队的请求都能走完
+    decodeQueue_.close();
+    for (auto& worker : decodeWorkers_) {
+        worker.join();
+    }
+    decodeWorkers_.clear();
+
+    for (auto& pair : models_) {
+        pair.second->queue.close();
+    }
+    for (auto& pair : models_) {
+        for (auto& worker : pair.second->workers) {
+            worker.join();
+        }
+        pair.second->workers.clear();
+    }
+
+    serializeQueue_.close();
+    for (auto& worker : serializeWorkers_) {
+        worker.join();
+    }
+    serializeWorkers_.clear();
+
+    LOGGER_INFO("Inference pipeline stopped");
+}
+
+InferencePipeline::Result InferencePipeline::execute(Job& job) {
+    if (!running_.load()) {
+        return Result::SHUTDOWN;
+    }
+
+    Ticket ticket;
+    ticket.job = &job;
+    if (!decodeQueue_.tryPush(&ticket)) {
+        rejected_.fetch_add(1, std::memory_order_relaxed);
+        return running_.load() ? Result::REJECTED : Result::SHUTDOWN;
+    }
+    submitted_.fetch_add(1, std::memory_order_relaxed);
+
+    std::unique_lock<std::mutex> lock(ticket.mutex);
+    ticket.condition.wait(lock, [&ticket] { return ticket.done; });
+    return ticket.result;
+}
+
+void InferencePipeline::complete(Ticket* ticket, Result result) {
+    if (result == Result::OK) {
+        completed_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        failed_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // 通知须在锁内完成：调用方醒来后 ticket 随即销毁
+    std::lock_guard<std::mutex> lock(ticket->mutex);
+    ticket->result = result;
+    ticket->done = true;
+    ticket->condition.notify_one();
+}
+
+void InferencePipeline::decodeLoop() {
+    Ticket* ticket = nullptr;
+    while (decodeQueue_.pop(ticket)) {
+        Job& job = *ticket->job;
+
+        if (std::chrono::steady_clock::now() >= job.priority.deadline) {
+            complete(ticket, Result::EXPIRED);
+            continue;
+        }
+
+        auto it = models_.find(job.modelType);
+        if (it == models_.end()) {
+            complete(ticket, Result::INFERENCE_FAILED);
+            continue;
+        }
+
+        auto decodeStart = std::chrono::steady_clock::now();
+        bool decoded = false;
+        try {
+            decoded = FramePool::getInstance().decode(job.data, job.size, cv::IMREAD_COLOR, *job.frame, job.inputSize);
+        } catch (const std::exception& e) {
+            LOGGER_ERROR("Pipeline decode error: " + std::string(e.what()));
+        }
+        decoded_.fetch_add(1, std::memory_order_relaxed);
+        if (!decoded) {
+            complete(ticket, Result::DECODE_FAILED);
+            continue;
+        }
+        if (job.timings) {
+            job.timings->mark(LatencyStage::IMAGE_DECODE, decodeStart);
+        }
+
+        // 推理队列满时在此等待，背压传到解码队列
+        if (!it->second->queue.push(ticket)) {
+            complete(ticket, Result::SHUTDOWN);
+        }
+    }
+}
+
+void InferencePipeline::inferenceLoop(ModelStage& stage) {
+    Ticket* ticket = nullptr;
+    while (stage.queue.pop(ticket)) {
+        Job& job = *ticket->job;
+
+        // 获取超时不超过请求剩余时间
+        int timeout = job.timeoutMs;
+        if (job.priority.deadline != std::chrono::steady_clock::time_point::max()) {
+            auto remainingMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    job.priority.deadline - std::chrono::steady_clock::now()).count();
+            timeout = static_cast<int>(std::min<long long>(timeout, std::max<long long>(0, remainingMs)));
+        }
+        if (timeout <= 0) {
+            complete(ticket, Result::EXPIRED);
+            continue;
+        }
+
+        bool success = false;
+        try {
+            success = infer_(job.modelType, job.frame->image(), job.params, timeout, job.priority,
+                             job.timings, *job.output);
+        } catch (const std::exception& e) {
+            LOGGER_ERROR("Pipeline inference error for model type " + std::to_string(job.modelType) +
+                          ": " + e.what());
+        }
+        stage.processed.fetch_add(1, std::memory_order_relaxed);
+        if (!success) {
+            complete(ticket, Result::INFERENCE_FAILED);
+            continue;
+        }
+
+        // 降采样解码时检测框换算回原图坐标
+        if (job.frame->reduced()) {
+            job.output->scaleBoxes(job.frame->scaleX(), job.frame->scaleY());
+        }
+
+        if (!job.serialize) {
+            complete(ticket, Result::OK);
+        } else if (!serializeQueue_.push(ticket)) {
+            complete(ticket, Result::SHUTDOWN);
+        }
+    }
+}
+
+void InferencePipeline::serializeLoop() {
+    Ticket* ticket = nullptr;
+    while (serializeQueue_.pop(ticket)) {
+        Result result = Result::OK;
+        try {
+            ticket->job->serialize();
+        } catch (const std::exception& e) {
+            LOGGER_ERROR("Pipeline serialize error: " + std::string(e.what()));
+            result = Result::SERIALIZE_FAILED;
+        }
+        serialized_.fetch_add(1, std::memory_order_relaxed);
+        complete(ticket, result);
+    }
+}
+
+InferencePipeline::Stats InferencePipeline::getStats() const {
+    Stats stats;
+    stats.running = running_.load();
+    stats.submitted = submitted_.load(std::memory_order_relaxed);
+    stats.rejected = rejected_.load(std::memory_order_relaxed);
+    stats.completed = completed_.load(std::memory_order_relaxed);
+    stats.failed = failed_.load(std::memory_order_relaxed);
+
+    StageStats decode;
+    decode.stage = "decode";
+    decode.queued = decodeQueue_.size();
+    decode.capacity = decodeQueue_.capacity();
+    decode.threads = options_.decodeThreads;
+    decode.processed = decoded_.load(std::memory_order_relaxed);
+    stats.stages.push_back(decode);
+
+    for (const auto& pair : models_) {
+        const ModelStage& stage = *pair.second;
+        StageStats inference;
+        inference.stage = "inference";
+        inference.modelType = stage.modelType;
+        inference.queued = stage.queue.size();
+        inference.capacity = stage.queue.capacity();
+        inference.threads = stage.workerCount;
+        inference.processed = stage.processed.load(std::memory_order_relaxed);
+        stats.stages.push_back(inference);
+    }
+
+    StageStats serialize;
+    serialize.stage = "serialize";
+    serialize.queued = serializeQueue_.size();
+    serialize.capacity = serializeQueue_.capacity();
+    serialize.threads = options_.serializeThreads;
+    serialize.processed = serialized_.load(std::memory_order_relaxed);
+    stats.stages.push_back(serialize);
+
+    return stats;
+}
+
+const char* InferencePipeline::resultToString(Result result) {
+    switch (result) {
+        case Result::OK:
+            return "OK";
+        case Result::REJECTED:
+            return "Inference pipeline is full";
+        case Result::DECODE_FAILED:
+            return "Image decode failed";
+        case Result::EXPIRED:
+            return "Request deadline exceeded before inference";
+        case Result::INFERENCE_FAILED:
+            return "Model inference failed";
+        case Result::SERIALIZE_FAILED:
+            return "Response serialization failed";
+        case Result::SHUTDOWN:
+            return "Inference pipeline is shutting down";
+        default:
+            return "Unknown";
+    }
+}
@@ -3,135 +3,476 @@
 //
 
 #include "AIService/ModelPool.h"
+#include "AIService/engine/InferenceEngineFactory.h"
+#include <algorithm>
 #include <fstream>
+#include <limits>
+#include <thread>
 
-bool ModelPool::initialize(const std::string& modelPath, int modelType, float threshold) {
+std::atomic<uint64_t> ModelPool::nextPoolId_{1};
+
+namespace {
+    // 线程亲和记录：池ID -> 当前线程上次使用的实例序号
+    thread_local std::unordered_map<uint64_t, size_t> t_lastSlot;
+}
+
+bool ModelPool::initialize(const EngineCreateInfo& info) {
     std::unique_lock<std::mutex> lock(poolMutex_);
 
-    if (!availableModels_.empty()) {
-        LOGGER_WARNING("Model pool already initialized for type: " + std::to_string(modelType));
+    if (slotCount_ > 0) {
+        LOGGER_WARNING("Model pool already initialized for type: " + std::to_string(info.modelType));
         return false;
     }
 
-    // 验证模型文件存在
-    std::ifstream modelFile(modelPath);
-    if (!modelFile.good()) {
-        LOGGER_ERROR("Model file does not exist: " + modelPath);
-        return false;
+    // 验证模型文件存在（CPU参考后端不需要模型文件）
+    if (InferenceEngineFactory::requiresModelFile(info.backend)) {
+        std::ifstream modelFile(info.modelPath);
+        if (!modelFile.good()) {
+            LOGGER_ERROR("Model file does not exist: " + info.modelPath);
+            return false;
+        }
+        modelFile.close();
     }
-    modelFile.close();
 
-    modelPath_ = modelPath;
-    modelType_ = modelType;
-    threshold_ = threshold;
+    createInfo_ = info;
+    modelPath_ = info.modelPath;
+    backend_ = info.backend;
+    modelType_ = info.modelType;
+    threshold_ = info.threshold;
 
-    LOGGER_INFO("Initializing model pool for type " + std::to_string(modelType) +
-                 " with " + std::to_string(maxPoolSize_) + " instances");
+    // 弹性伸缩：槽位按最大实例数预留，初始只创建 poolSize_ 个实例
+    elastic_ = options_.maxInstances > poolSize_;
+    minInstances_ = elastic_ && options_.minInstances > 0 ? std::min(options_.minInstances, poolSize_) : poolSize_;
+    maxInstances_ = elastic_ ? options_.maxInstances : poolSize_;
+
+    LOGGER_INFO("Initializing model pool for type " + std::to_string(info.modelType) +
+                 " with " + std::to_string(poolSize_) + " instances, backend: " + info.backend +
+                 (elastic_ ? ", elastic range: " + std::to_string(minInstances_) + "-" +
+                             std::to_string(maxInstances_) : std::string()));
+
+    std::unique_ptr<InstanceSlot[]> slots(new InstanceSlot[maxInstances_]);
+    int64_t nowNs = steadyNanos();
 
     // 创建模型实例池
-    for (size_t i = 0; i < maxPoolSize_; ++i) {
+    for (size_t i = 0; i < poolSize_; ++i) {
         try {
-            auto model = std::make_shared<rknn_lite>(
-                    const_cast<char*>(modelPath.c_str()),
-                    modelType % 3,
-                    modelType,
-                    threshold
-            );
+            auto model = createEngine(i);
+            if (!model) {
+                throw std::runtime_error("no engine available for backend " + info.backend);
+            }
 
-            availableModels_.push(model);
-            allModels_.insert(model);
+            slots[i].engine = model;
+            slots[i].engineKey.store(model.get());
+            slots[i].activeSinceNs.store(nowNs);
 
-            LOGGER_DEBUG("Created model instance " + std::to_string(i) + " for type " + std::to_string(modelType));
+            LOGGER_DEBUG("Created model instance " + std::to_string(i) + " for type " + std::to_string(info.modelType));
 
         } catch (const std::exception& e) {
             LOGGER_ERROR("Failed to create model instance " + std::to_string(i) +
-                          " for type " + std::to_string(modelType) + ": " + e.what());
+                          " for type " + std::to_string(info.modelType) + ": " + e.what());
 
-            // 清理已创建的实例
-            while (!availableModels_.empty()) {
-                availableModels_.pop();
-            }
-            allModels_.clear();
+            // 已创建的实例随slots一起释放
             return false;
         }
     }
 
+    for (size_t i = poolSize_; i < maxInstances_; ++i) {
+        slots[i].state.store(SLOT_EMPTY);
+    }
+
+    if (poolSize_ > 0) {
+        inputSize_ = slots[0].engine->getInputSize();
+    }
+
+    // 发布槽位并填充空闲队列
+    slots_ = std::move(slots);
+    slotCount_ = maxInstances_;
+    freeSlots_.reset(slotCount_);
+
+    for (size_t i = 0; i < poolSize_; ++i) {
+        slots_[i].inRing.store(true);
+        freeSlots_.push(i);
+    }
+    activeInstances_.store(poolSize_);
+
+    createdAt_ = std::chrono::steady_clock::now();
+    lastScaleNs_ = nowNs;
     enabled_.store(true);
-    LOGGER_INFO("Model pool initialized successfully for type " + std::to_string(modelType) +
-                 " with " + std::to_string(maxPoolSize_) + " instances");
+
+    if (elastic_ || options_.trimIdleMs > 0) {
+        maintenanceThread_ = std::thread(&ModelPool::maintenanceLoop, this);
+    }
+
+    LOGGER_INFO("Model pool initialized successfully for type " + std::to_string(info.modelType) +
+                 " with " + std::to_string(poolSize_) + " instances");
     return true;
 }
 
-std::shared_ptr<rknn_lite> ModelPool::acquireModel(int timeoutMs) {
+std::shared_ptr<InferenceEngine> ModelPool::createEngine(size_t index) const {
+    EngineCreateInfo instanceInfo = createInfo_;
+    instanceInfo.instanceIndex = index;
+    return InferenceEngineFactory::create(instanceInfo);
+}
+
+bool ModelPool::getAffinitySlot(size_t& index) const {
+    auto it = t_lastSlot.find(poolId_);
+    if (it == t_lastSlot.end() || it->second >= slotCount_) {
+        return false;
+    }
+    index = it->second;
+    return true;
+}
+
+void ModelPool::setAffinitySlot(size_t index) const {
+    t_lastSlot[poolId_] = index;
+}
+
+bool ModelPool::claimSlot(size_t index) {
+    int expected = SLOT_FREE;
+    if (!slots_[index].state.compare_exchange_strong(expected, SLOT_BUSY)) {
+        return false;
+    }
+    slots_[index].busySinceNs.store(steadyNanos(), std::memory_order_relaxed);
+
+    // 记录同时占用实例数的峰值，供弹性伸缩判断是否有多余实例
+    if (elastic_) {
+        int busy = busyInstances_.fetch_add(1, std::memory_order_relaxed) + 1;
+        int peak = peakBusy_.load(std::memory_order_relaxed);
+        while (busy > peak && !peakBusy_.compare_exchange_weak(peak, busy, std::memory_order_relaxed)) {
+        }
+    }
+    return true;
+}
+
+void ModelPool::markSlotFree(size_t index) {
+    auto& slot = slots_[index];
+    int64_t nowNs = steadyNanos();
+    int64_t busyFor = nowNs - slot.busySinceNs.load(std::memory_order_relaxed);
+    if (busyFor > 0) {
+        slot.busyNanos.fetch_add(static_cast<uint64_t>(busyFor), std::memory_order_relaxed);
+    }
+    slot.lastReleaseNs.store(nowNs, std::memory_order_relaxed);
+    if (elastic_) {
+        busyInstances_.fetch_sub(1, std::memory_order_relaxed);
+    }
+    slot.state.store(SLOT_FREE);
+}
+
+void ModelPool::recordAcquire(size_t index, std::chrono::steady_clock::time_point acquireStart) {
+    slots_[index].acquireCount.fetch_add(1, std::memory_order_relaxed);
+    auto waitUs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - acquireStart).count());
+    acquireWait_.record(waitUs);
+    if (elastic_) {
+        recentWait_.record(waitUs);
+    }
+}
+
+bool ModelPool::tryAcquireSlot(size_t& index) {
+    // 快速路径：复用当前线程上次使用的实例
+    if (options_.threadAffinity && getAffinitySlot(index) && claimSlot(index)) {
+        return true;
+    }
+
+    // 从空闲队列中取出序号，跳过已被亲和路径占用的过期序号
+    while (freeSlots_.pop(index)) {
+        slots_[index].inRing.store(false);
+        if (claimSlot(index)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+int ModelPool::acquireSlot(int timeoutMs, const AcquirePriority& priority) {
+    auto acquireStart = std::chrono::steady_clock::now();
     totalAcquires_++;
 
     if (!enabled_.load() || shutdown_.load()) {
-        LOGGER_DEBUG("Model pool disabled or shutdown for type: " + std::to_string(modelType_));
-        return nullptr;
+        LOGGER_DEBUG_F("Model pool disabled or shutdown for type: {}", modelType_);
+        return -1;
     }
 
-    std::unique_lock<std::mutex> lock(poolMutex_);
+    size_t index = 0;
 
-    // 等待可用模型或超时
-    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    // 自旋阶段（已有休眠等待者时空闲实例会被直接交给队首，自旋没有意义）
+    int spinIterations = parkedWaiters_.load() > 0 ? 0 : options_.spinIterations;
+    for (int spin = 0; spin <= spinIterations; ++spin) {
+        if (tryAcquireSlot(index)) {
+            recordAcquire(index, acquireStart);
+            LOGGER_DEBUG_F("Acquired model {} for type {}", index, modelType_);
+            return static_cast<int>(index);
+        }
+        if ((spin & 0xF) == 0xF) {
+            std::this_thread::yield();
+        } else {
+            cpuRelax();
+        }
+    }
 
-    if (!condition_.wait_until(lock, deadline, [this] {
-        return !availableModels_.empty() || shutdown_.load();
-    })) {
-        timeoutCount_++;
-        LOGGER_WARNING("Model acquisition timeout after " + std::to_string(timeoutMs) +
-                        "ms for type: " + std::to_string(modelType_));
-        return nullptr;
+    // 休眠等待阶段：按优先级和截止时间排队，等待截止时间取超时与请求截止时间中较早者
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    if (priority.deadline < deadline) {
+        deadline = priority.deadline;
     }
 
-    if (shutdown_.load() || availableModels_.empty()) {
-        return nullptr;
+    Waiter waiter;
+    waiter.priority = priority.priority;
+    waiter.deadline = deadline;
+    bool acquired = false;
+    bool rejected = false;
+
+    {
+        std::unique_lock<std::mutex> lock(parkMutex_);
+        waiter.sequence = nextWaiterSequence_++;
+        parkedWaiters_++;
+
+        // 先登记再检查空闲队列，与 releaseSlot 中“先入队再检查等待者”配合，避免丢失唤醒
+        if (tryAcquireSlot(index)) {
+            acquired = true;
+        } else if (options_.maxWaiters > 0 && waiters_.size() >= options_.maxWaiters) {
+            // 等待队列已满：立即失败，避免请求在池前无限堆积
+            rejected = true;
+        } else {
+            waiters_.insert(&waiter);
+
+            while (!shutdown_.load() && waiter.grantedIndex < 0) {
+                if (waiter.condition.wait_until(lock, deadline) == std::cv_status::timeout) {
+                    break;
+                }
+                // 被唤醒但未被分配时，空闲队列中可能有实例（归还时尚无等待者）
+                if (waiter.grantedIndex < 0 && !shutdown_.load() && tryAcquireSlot(index)) {
+                    acquired = true;
+                    break;
+                }
+            }
+
+            waiters_.erase(&waiter);
+
+            // 空闲队列中仍有实例时交给新的队首处理（本等待者可能在被唤醒时恰好超时）
+            if (!waiters_.empty() && freeSlots_.sizeApprox() > 0) {
+                (*waiters_.begin())->condition.notify_one();
+            }
+
+            if (waiter.grantedIndex >= 0) {
+                index = static_cast<size_t>(waiter.grantedIndex);
+                acquired = true;
+            }
+
+            if (acquired && shutdown_.load()) {
+                // 关闭期间被分配的实例直接归还
+                markSlotFree(index);
+                acquired = false;
+            }
+        }
+
+        parkedWaiters_--;
     }
 
-    auto model = availableModels_.front();
-    availableModels_.pop();
+    if (rejected) {
+        rejectedCount_++;
+        // 拒绝同样说明排队过长，按完整超时计入伸缩评估
+        if (elastic_) {
+            recentWait_.record(static_cast<uint64_t>(std::max(timeoutMs, 0)) * 1000);
+        }
+        LOGGER_WARNING_F("Model acquisition rejected for type {}: {} requests already waiting",
+                         modelType_, options_.maxWaiters);
+        return -1;
+    }
 
-    LOGGER_DEBUG("Acquired model for type " + std::to_string(modelType_) +
-                  ", remaining available: " + std::to_string(availableModels_.size()));
+    if (!acquired) {
+        if (!shutdown_.load()) {
+            timeoutCount_++;
+            // 超时同样是排队信号，计入伸缩评估
+            if (elastic_) {
+                recentWait_.record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::steady_clock::now() - acquireStart).count()));
+            }
+            LOGGER_WARNING("Model acquisition timeout after " + std::to_string(timeoutMs) +
+                            "ms for type: " + std::to_string(modelType_));
+        }
+        return -1;
+    }
 
-    return model;
+    recordAcquire(index, acquireStart);
+    LOGGER_DEBUG_F("Acquired model {} for type {} after waiting", index, modelType_);
+    return static_cast<int>(index);
 }
 
-void ModelPool::releaseModel(std::shared_ptr<rknn_lite> model) {
-    if (!model || shutdown_.load()) {
+void ModelPool::releaseSlot(int index) {
+    if (index < 0 || static_cast<size_t>(index) >= slotCount_) {
+        LOGGER_ERROR("Attempt to release invalid model slot " + std::to_string(index) +
+                      " for pool type: " + std::to_string(modelType_));
         return;
     }
 
     totalReleases_++;
 
-    // 验证这个模型确实属于这个池
-    if (allModels_.find(model) == allModels_.end()) {
+    if (options_.threadAffinity) {
+        setAffinitySlot(static_cast<size_t>(index));
+    }
+
+    returnSlot(static_cast<size_t>(index));
+}
+
+void ModelPool::returnSlot(size_t index) {
+    // 存在休眠等待者时直接把实例交给队首（实例保持占用状态，不经过空闲队列）
+    if (parkedWaiters_.load() > 0) {
+        std::lock_guard<std::mutex> lock(parkMutex_);
+        if (handOffToWaiter(index)) {
+            LOGGER_DEBUG_F("Handed off model {} for type {}", index, modelType_);
+            return;
+        }
+    }
+
+    auto& slot = slots_[index];
+    markSlotFree(index);
+
+    // 序号不在队列中时才入队，保证每个序号最多出现一次（队列容量不小于槽位数，不会失败）
+    if (!slot.inRing.exchange(true)) {
+        freeSlots_.push(index);
+    }
+
+    // 入队后再次检查：等待者可能在上面的检查之后才登记，唤醒队首重新尝试
+    if (parkedWaiters_.load() > 0) {
+        std::lock_guard<std::mutex> lock(parkMutex_);
+        if (!waiters_.empty()) {
+            (*waiters_.begin())->condition.notify_one();
+        }
+    }
+
+    LOGGER_DEBUG_F("Released model {} for type {}", index, modelType_);
+}
+
+bool ModelPool::handOffToWaiter(size_t index) {
+    if (waiters_.empty() || shutdown_.load()) {
+        return false;
+    }
+
+    auto it = waiters_.begin();
+    Waiter* waiter = *it;
+    waiters_.erase(it);
+
+    waiter->grantedIndex = static_cast<int>(index);
+    waiter->condition.notify_one();
+    return true;
+}
+
+void ModelPool::notifyAllWaiters() {
+    for (auto* waiter : waiters_) {
+        waiter->condition.notify_one();
+    }
+}
+
+std::shared_ptr<InferenceEngine> ModelPool::getSlotEngine(int index) const {
+    if (index < 0 || static_cast<size_t>(index) >= slotCount_) {
+        return nullptr;
+    }
+    return slots_[index].engine;
+}
+
+std::shared_ptr<InferenceEngine> ModelPool::acquireModel(int timeoutMs) {
+    return getSlotEngine(acquireSlot(timeoutMs));
+}
+
+void ModelPool::releaseModel(std::shared_ptr<InferenceEngine> model) {
+    if (!model || shutdown_.load()) {
+        return;
+    }
+
+    // 验证这个模型确实属于这个池（调用方持有的实例所在槽位处于占用状态，不会被伸缩线程修改）
+    int index = -1;
+    for (size_t i = 0; i < slotCount_; ++i) {
+        if (slots_[i].engineKey.load() == model.get() && slots_[i].state.load() == SLOT_BUSY) {
+            index = static_cast<int>(i);
+            break;
+        }
+    }
+    if (index < 0) {
         LOGGER_ERROR("Attempt to release model that doesn't belong to pool type: " +
                       std::to_string(modelType_));
         return;
     }
 
     clearModelResources(model);
-
-    std::unique_lock<std::mutex> lock(poolMutex_);
-    availableModels_.push(model);
-    condition_.notify_one();
-
-    LOGGER_DEBUG("Released model for type " + std::to_string(modelType_) +
-                  ", available: " + std::to_string(availableModels_.size()));
+    releaseSlot(index);
 }
 
 ModelPool::PoolStatus ModelPool::getStatus() const {
-    std::unique_lock<std::mutex> lock(poolMutex_);
-
     PoolStatus status;
-    status.totalModels = allModels_.size();
-    status.availableModels = availableModels_.size();
-    status.busyModels = status.totalModels - status.availableModels;
+    status.totalModels = 0;
+    status.availableModels = 0;
+    status.busyModels = 0;
     status.isEnabled = enabled_.load();
     status.modelPath = modelPath_;
+    status.backend = backend_;
     status.modelType = modelType_;
     status.threshold = threshold_;
+    status.totalAcquires = totalAcquires_.load(std::memory_order_relaxed);
+    status.totalReleases = totalReleases_.load(std::memory_order_relaxed);
+    status.timeoutCount = timeoutCount_.load(std::memory_order_relaxed);
+    status.rejectedCount = rejectedCount_.load(std::memory_order_relaxed);
+    status.maxWaiters = options_.maxWaiters;
+    status.waitingRequests = static_cast<size_t>(std::max(0, parkedWaiters_.load()));
+    status.elastic = elastic_;
+    status.minInstances = minInstances_;
+    status.maxInstances = maxInstances_;
+    status.scaleUps = scaleUps_.load(std::memory_order_relaxed);
+    status.scaleDowns = scaleDowns_.load(std::memory_order_relaxed);
+    status.trimCount = trimCount_.load(std::memory_order_relaxed);
+
+    if (slotCount_ == 0) {
+        return status;
+    }
+
+    // 时间加权的占用统计：已结束的占用区间 + 进行中的占用；
+    // 分母为各实例的存活时间之和，弹性伸缩回收的实例也计入
+    int64_t nowNs = steadyNanos();
+    uint64_t totalBusyNanos = 0;
+    uint64_t totalActiveNanos = 0;
+    status.instances.reserve(slotCount_);
+    for (size_t i = 0; i < slotCount_; ++i) {
+        const auto& slot = slots_[i];
+        int state = slot.state.load(std::memory_order_relaxed);
+        uint64_t busyNanos = slot.busyNanos.load(std::memory_order_relaxed);
+        uint64_t activeNanos = slot.activeNanos.load(std::memory_order_relaxed);
+        bool busy = state == SLOT_BUSY;
+        if (busy) {
+            int64_t inFlight = nowNs - slot.busySinceNs.load(std::memory_order_relaxed);
+            if (inFlight > 0) {
+                busyNanos += static_cast<uint64_t>(inFlight);
+            }
+        }
+        if (state != SLOT_EMPTY) {
+            int64_t alive = nowNs - slot.activeSinceNs.load(std::memory_order_relaxed);
+            if (alive > 0) {
+                activeNanos += static_cast<uint64_t>(alive);
+            }
+        }
+        totalBusyNanos += busyNanos;
+        totalActiveNanos += activeNanos;
+
+        if (state == SLOT_EMPTY) {
+            continue;
+        }
+        status.totalModels++;
+        if (busy) {
+            status.busyModels++;
+        } else {
+            status.availableModels++;
+        }
+        status.instances.push_back({i, busy, slot.acquireCount.load(std::memory_order_relaxed),
+                                    static_cast<double>(busyNanos) / 1e9});
+    }
+
+    status.uptimeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - createdAt_).count();
+    status.busyTimeSeconds = static_cast<double>(totalBusyNanos) / 1e9;
+    if (totalActiveNanos > 0) {
+        status.utilization = std::min(1.0, static_cast<double>(totalBusyNanos) / static_cast<double>(totalActiveNanos));
+    }
+    status.totalWaitSeconds = static_cast<double>(acquireWait_.sumMicros()) / 1e6;
+    status.acquireWait = acquireWait_.snapshot();
 
     return status;
 }
@@ -144,8 +485,8 @@ void ModelPool::setEnabled(bool enabled) {
 
         if (enabled) {
             // 通知等待的线程
-            std::unique_lock<std::mutex> lock(poolMutex_);
-            condition_.notify_all();
+            std::lock_guard<std::mutex> lock(parkMutex_);
+            notifyAllWaiters();
         }
     }
 }
@@ -157,14 +498,21 @@ void ModelPool::shutdown() {
 
     LOGGER_INFO("Shutting down model pool for type: " + std::to_string(modelType_));
 
-    std::unique_lock<std::mutex> lock(poolMutex_);
-    condition_.notify_all();
+    {
+        std::lock_guard<std::mutex> lock(parkMutex_);
+        notifyAllWaiters();
+    }
 
-    // 清理资源
-    while (!availableModels_.empty()) {
-        availableModels_.pop();
+    // 停止后台维护线程（可能正在创建实例，等待其完成）
+    {
+        std::lock_guard<std::mutex> lock(maintenanceMutex_);
+        maintenanceCondition_.notify_all();
+    }
+    if (maintenanceThread_.joinable()) {
+        maintenanceThread_.join();
     }
-    allModels_.clear();
+
+    // 实例在池析构时释放，避免与仍在归还实例的线程竞争
 
     LOGGER_INFO("Model pool shutdown completed for type: " + std::to_string(modelType_) +
                  ", total acquires: " + std::to_string(totalAcquires_.load()) +
@@ -172,13 +520,176 @@ void ModelPool::shutdown() {
                  ", timeouts: " + std::to_string(timeoutCount_.load()));
 }
 
-void ModelPool::clearModelResources(std::shared_ptr<rknn_lite> model) {
+void ModelPool::maintenanceLoop() {
+    std::unique_lock<std::mutex> lock(maintenanceMutex_);
+    while (!shutdown_.load()) {
+        maintenanceCondition_.wait_for(lock, std::chrono::milliseconds(options_.scaleIntervalMs),
+                                  [this] { return shutdown_.load(); });
+        if (shutdown_.load()) {
+            break;
+        }
+
+        // 创建实例可能耗时较长（加载模型），不持有锁
+        lock.unlock();
+        if (elastic_) {
+            evaluateScaling();
+        }
+        if (options_.trimIdleMs > 0) {
+            trimIdleInstances();
+        }
+        lock.lock();
+    }
+}
+
+void ModelPool::trimIdleInstances() {
+    const int64_t idleNs = static_cast<int64_t>(options_.trimIdleMs) * 1000000;
+
+    for (size_t i = 0; i < slotCount_ && !shutdown_.load(); ++i) {
+        auto& slot = slots_[i];
+        int64_t lastRelease = slot.lastReleaseNs.load(std::memory_order_relaxed);
+
+        // 只处理上次回收之后被使用过、且已空闲足够久的实例
+        if (lastRelease <= slot.trimmedAtNs || steadyNanos() - lastRelease < idleNs) {
+            continue;
+        }
+
+        // 以占用状态回收，期间获取方会跳过该实例；完成后按正常归还流程放回
+        int expected = SLOT_FREE;
+        if (!slot.state.compare_exchange_strong(expected, SLOT_BUSY)) {
+            continue;
+        }
+        slot.busySinceNs.store(steadyNanos(), std::memory_order_relaxed);
+        if (elastic_) {
+            busyInstances_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        slot.engine->trimResources();
+        trimCount_++;
+
+        returnSlot(i);
+        slot.trimmedAtNs = steadyNanos();
+        LOGGER_DEBUG_F("Trimmed working set of model {} for type {}", i, modelType_);
+    }
+}
+
+void ModelPool::evaluateScaling() {
+    int64_t nowNs = steadyNanos();
+    uint64_t samples = recentWait_.count();
+    uint64_t waitP95Us = recentWait_.valueAtQuantile(0.95);
+    recentWait_.reset();
+
+    size_t active = activeInstances_.load();
+
+    // 扩容：本周期内获取等待的p95超过阈值
+    if (samples > 0 && waitP95Us > static_cast<uint64_t>(options_.scaleUpWaitMs) * 1000 &&
+        active < maxInstances_ && enabled_.load()) {
+        if (growInstance()) {
+            scaleUps_++;
+            LOGGER_INFO_F("Model pool for type {} scaled up to {} instances (acquire wait p95 {}us over {} samples)",
+                          modelType_, activeInstances_.load(), waitP95Us, samples);
+        }
+        lastScaleNs_ = nowNs;
+        peakBusy_.store(busyInstances_.load());
+        return;
+    }
+
+    // 缩容：整个观察期内同时占用的实例数始终小于实例总数，说明至少有一个实例多余
+    if (nowNs - lastScaleNs_ < static_cast<int64_t>(options_.scaleDownIdleMs) * 1000000) {
+        return;
+    }
+    int peak = peakBusy_.exchange(busyInstances_.load());
+    lastScaleNs_ = nowNs;
+    if (active > minInstances_ && peak < static_cast<int>(active) && retireInstance()) {
+        scaleDowns_++;
+        LOGGER_INFO_F("Model pool for type {} scaled down to {} instances (peak busy {} in the last {}ms)",
+                      modelType_, activeInstances_.load(), peak, options_.scaleDownIdleMs);
+    }
+}
+
+bool ModelPool::growInstance() {
+    size_t index = slotCount_;
+    for (size_t i = 0; i < slotCount_; ++i) {
+        if (slots_[i].state.load() == SLOT_EMPTY) {
+            index = i;
+            break;
+        }
+    }
+    if (index == slotCount_) {
+        return false;
+    }
+
+    std::shared_ptr<InferenceEngine> engine;
+    try {
+        engine = createEngine(index);
+    } catch (const std::exception& e) {
+        LOGGER_ERROR("Failed to create model instance " + std::to_string(index) +
+                      " for type " + std::to_string(modelType_) + ": " + e.what());
+        return false;
+    }
+    if (!engine) {
+        return false;
+    }
+
+    // 槽位处于 SLOT_EMPTY 时其他线程不会访问 engine；以占用状态发布后走归还流程，
+    // 有等待者时直接交给队首
+    auto& slot = slots_[index];
+    int64_t nowNs = steadyNanos();
+    slot.engineKey.store(engine.get());
+    slot.engine = std::move(engine);
+    slot.activeSinceNs.store(nowNs, std::memory_order_relaxed);
+    slot.busySinceNs.store(nowNs, std::memory_order_relaxed);
+    busyInstances_.fetch_add(1, std::memory_order_relaxed);
+    slot.state.store(SLOT_BUSY);
+    activeInstances_++;
+
+    returnSlot(index);
+    return true;
+}
+
+bool ModelPool::retireInstance() {
+    // 选择最久未被使用的空闲实例
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        size_t index = slotCount_;
+        int64_t oldestRelease = std::numeric_limits<int64_t>::max();
+        for (size_t i = 0; i < slotCount_; ++i) {
+            if (slots_[i].state.load() != SLOT_FREE) {
+                continue;
+            }
+            int64_t lastRelease = slots_[i].lastReleaseNs.load(std::memory_order_relaxed);
+            if (lastRelease < oldestRelease) {
+                oldestRelease = lastRelease;
+                index = i;
+            }
+        }
+        if (index == slotCount_) {
+            return false;
+        }
+
+        // CAS 失败说明刚被占用，重新挑选；空闲队列中残留的序号在出队时被过滤
+        int expected = SLOT_FREE;
+        auto& slot = slots_[index];
+        if (!slot.state.compare_exchange_strong(expected, SLOT_EMPTY)) {
+            continue;
+        }
+
+        int64_t alive = steadyNanos() - slot.activeSinceNs.load(std::memory_order_relaxed);
+        if (alive > 0) {
+            slot.activeNanos.fetch_add(static_cast<uint64_t>(alive), std::memory_order_relaxed);
+        }
+        activeInstances_--;
+        slot.engineKey.store(nullptr);
+
+        // 释放实例占用的内存（RKNN 上下文等）
+        std::shared_ptr<InferenceEngine> engine = std::move(slot.engine);
+        engine.reset();
+        return true;
+    }
+    return false;
+}
+
+void ModelPool::clearModelResources(std::shared_ptr<InferenceEngine> model) {
     if (model) {
         // 清理模型内部资源
-        model->ori_img.release();
-        model->results_vector.clear();
-        model->results_vector.shrink_to_fit();
-        model->plateResults.clear();
-        model->plateResults.shrink_to_fit();
+        model->releaseResources();
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,116 @@
+//
+// Created by YJK on 2026/10/16.
+//
+
+#include "AIService/engine/CpuReferenceEngine.h"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+namespace {
+    // splitmix64：简单、无状态依赖的伪随机数生成
+    uint64_t nextRandom(uint64_t& state) {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    double nextUnit(uint64_t& state) {
+        return static_cast<double>(nextRandom(state) >> 11) * (1.0 / 9007199254740992.0);
+    }
+}
+
+CpuReferenceEngine::CpuReferenceEngine(const EngineCreateInfo& info)
+        : modelType_(info.modelType),
+          threshold_(info.threshold),
+          latencyMs_(std::max(0, info.cpuLatencyMs)),
+          detectionCount_(std::max(0, info.cpuDetectionCount)),
+          inputSize_(info.inputWidth, info.inputHeight),
+          keypointStride_(static_cast<uint32_t>(std::max(0, info.keypointStride))) {}
+
+uint64_t CpuReferenceEngine::computeSeed(const cv::Mat& image) const {
+    // FNV-1a，对尺寸和最多64个采样像素求哈希
+    uint64_t hash = 1469598103934665603ULL;
+    auto mix = [&hash](uint64_t v) {
+        hash ^= v;
+        hash *= 1099511628211ULL;
+    };
+
+    mix(static_cast<uint64_t>(modelType_));
+    mix(static_cast<uint64_t>(image.cols));
+    mix(static_cast<uint64_t>(image.rows));
+
+    if (!image.empty() && image.isContinuous()) {
+        size_t totalBytes = image.total() * image.elemSize();
+        size_t stride = std::max<size_t>(1, totalBytes / 64);
+        for (size_t offset = 0; offset < totalBytes; offset += stride) {
+            mix(image.data[offset]);
+        }
+    }
+
+    return hash;
+}
+
+bool CpuReferenceEngine::generate(const cv::Mat& image, const InferenceParams& params, InferenceOutput& output) const {
+    if (image.empty()) {
+        return false;
+    }
+
+    uint64_t state = computeSeed(image);
+
+    output.clear();
+    output.reserve(detectionCount_);
+    output.keypointStride = keypointStride_;
+
+    // 检测框格式：[x1, y1, x2, y2, score, class_id]
+    for (int i = 0; i < detectionCount_; ++i) {
+        int boxWidth = std::max(1, static_cast<int>(image.cols * (0.05 + 0.25 * nextUnit(state))));
+        int boxHeight = std::max(1, static_cast<int>(image.rows * (0.05 + 0.25 * nextUnit(state))));
+        int x1 = static_cast<int>((image.cols - boxWidth) * nextUnit(state));
+        int y1 = static_cast<int>((image.rows - boxHeight) * nextUnit(state));
+        float score = threshold_ + static_cast<float>((1.0 - threshold_) * nextUnit(state));
+        int classId = static_cast<int>(nextRandom(state) % 4);
+
+        output.addDetection(static_cast<float>(x1), static_cast<float>(y1),
+                            static_cast<float>(x1 + boxWidth), static_cast<float>(y1 + boxHeight), score, classId);
+    }
+
+    if (modelType_ == 4) {
+        for (int i = 0; i < detectionCount_; ++i) {
+            output.plateResults.push_back("CPU" + std::to_string(nextRandom(state) % 100000));
+        }
+    } else if (modelType_ == 5) {
+        output.value = params.startValue + (params.endValue - params.startValue) * nextUnit(state);
+    }
+
+    return true;
+}
+
+bool CpuReferenceEngine::infer(const cv::Mat& image, const InferenceParams& params, InferenceOutput& output) {
+    auto start = std::chrono::steady_clock::now();
+
+    bool success = generate(image, params, output);
+
+    // 模拟NPU推理耗时（扣除已消耗的时间）
+    if (success && latencyMs_ > 0) {
+        std::this_thread::sleep_until(start + std::chrono::milliseconds(latencyMs_));
+    }
+
+    return success;
+}
+
+void CpuReferenceEngine::inferBatch(const std::vector<cv::Mat>& images,
+                                    const std::vector<InferenceParams>& params,
+                                    std::vector<InferenceOutput>& outputs,
+                                    std::vector<char>& success) {
+    auto start = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < images.size(); ++i) {
+        success[i] = generate(images[i], params[i], outputs[i]) ? 1 : 0;
+    }
+
+    if (latencyMs_ > 0) {
+        std::this_thread::sleep_until(start + std::chrono::milliseconds(latencyMs_));
+    }
+}
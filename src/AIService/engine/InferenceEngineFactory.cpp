@@ -0,0 +1,90 @@
+//
+// Created by YJK on 2026/10/16.
+//
+
+#include "AIService/engine/InferenceEngineFactory.h"
+#include "AIService/engine/CpuReferenceEngine.h"
+#ifdef USE_RKNN
+#include "AIService/engine/RknnInferenceEngine.h"
+#endif
+#include "common/Logger.h"
+
+std::mutex InferenceEngineFactory::registryMutex_;
+
+std::map<std::string, std::map<int, InferenceEngineFactory::Creator>>& InferenceEngineFactory::registry() {
+    static std::map<std::string, std::map<int, Creator>> creators;
+    return creators;
+}
+
+std::map<std::string, bool>& InferenceEngineFactory::modelFileRequirements() {
+    static std::map<std::string, bool> requirements;
+    return requirements;
+}
+
+void InferenceEngineFactory::registerBuiltinEngines() {
+    static std::once_flag builtinFlag;
+    std::call_once(builtinFlag, []() {
+#ifdef USE_RKNN
+        // 所有模型类型共用 rknn_lite 实现，由 rknn_lite 内部按模型类型选择前后处理
+        registerCreator("rknn", ANY_MODEL_TYPE, [](const EngineCreateInfo& info) {
+            return std::make_shared<RknnInferenceEngine>(info);
+        });
+#endif
+        registerCreator("cpu", ANY_MODEL_TYPE, [](const EngineCreateInfo& info) {
+            return std::make_shared<CpuReferenceEngine>(info);
+        }, false);
+    });
+}
+
+void InferenceEngineFactory::registerCreator(const std::string& backend, int modelType, Creator creator,
+                                             bool requiresModelFile) {
+    std::lock_guard<std::mutex> lock(registryMutex_);
+    registry()[backend][modelType] = std::move(creator);
+    modelFileRequirements()[backend] = requiresModelFile;
+}
+
+std::shared_ptr<InferenceEngine> InferenceEngineFactory::create(const EngineCreateInfo& info) {
+    registerBuiltinEngines();
+
+    Creator creator;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex_);
+
+        auto backendIt = registry().find(info.backend);
+        if (backendIt == registry().end()) {
+            LOGGER_ERROR("Inference backend not registered: " + info.backend);
+            return nullptr;
+        }
+
+        // 优先使用模型类型专用实现，否则回退到后端默认实现
+        auto creatorIt = backendIt->second.find(info.modelType);
+        if (creatorIt == backendIt->second.end()) {
+            creatorIt = backendIt->second.find(ANY_MODEL_TYPE);
+        }
+
+        if (creatorIt == backendIt->second.end()) {
+            LOGGER_ERROR("Inference backend " + info.backend + " does not support model type: " +
+                          std::to_string(info.modelType));
+            return nullptr;
+        }
+
+        creator = creatorIt->second;
+    }
+
+    return creator(info);
+}
+
+bool InferenceEngineFactory::hasBackend(const std::string& backend) {
+    registerBuiltinEngines();
+
+    std::lock_guard<std::mutex> lock(registryMutex_);
+    return registry().find(backend) != registry().end();
+}
+
+bool InferenceEngineFactory::requiresModelFile(const std::string& backend) {
+    registerBuiltinEngines();
+
+    std::lock_guard<std::mutex> lock(registryMutex_);
+    auto it = modelFileRequirements().find(backend);
+    return it == modelFileRequirements().end() || it->second;
+}
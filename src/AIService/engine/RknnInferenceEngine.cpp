@@ -0,0 +1,101 @@
+//
+// Created by YJK on 2026/10/16.
+//
+
+#include "AIService/engine/RknnInferenceEngine.h"
+#include <algorithm>
+#include <any>
+#include <cmath>
+
+namespace {
+    // rknn_lite 输出中的数值统一转为double，非数值类型按0处理
+    double numericValue(const std::any& value) {
+        if (value.type() == typeid(int)) {
+            return *std::any_cast<int>(&value);
+        }
+        if (value.type() == typeid(float)) {
+            return *std::any_cast<float>(&value);
+        }
+        if (value.type() == typeid(double)) {
+            return *std::any_cast<double>(&value);
+        }
+        if (value.type() == typeid(bool)) {
+            return *std::any_cast<bool>(&value) ? 1.0 : 0.0;
+        }
+        return 0.0;
+    }
+}
+
+RknnInferenceEngine::RknnInferenceEngine(const EngineCreateInfo& info)
+        : modelType_(info.modelType),
+          inputSize_(info.inputWidth, info.inputHeight),
+          keypointStride_(static_cast<uint32_t>(std::max(0, info.keypointStride))) {
+    // NPU核心：配置了 npu_cores 时按实例序号轮流分配，否则按模型类型分配（与原模型池保持一致）
+    int npuCore = info.npuCores.empty() ? info.modelType % 3
+                                        : info.npuCores[info.instanceIndex % info.npuCores.size()];
+    model_ = std::make_unique<rknn_lite>(
+            const_cast<char*>(info.modelPath.c_str()),
+            npuCore,
+            info.modelType,
+            info.threshold
+    );
+}
+
+bool RknnInferenceEngine::infer(const cv::Mat& image, const InferenceParams& params, InferenceOutput& output) {
+    // 已知模型输入尺寸时先缩放到实例的输入缓冲（尺寸不变，不再每次分配），
+    // rknn_lite 收到的图像已是输入尺寸，不再自行缩放；结果随后换算回原图坐标
+    bool resized = !inputSize_.empty() && image.size() != inputSize_;
+    if (resized) {
+        cv::resize(image, inputBuffer_, inputSize_);
+        model_->ori_img = inputBuffer_;
+    } else {
+        model_->ori_img = image;
+    }
+    model_->startValue = params.startValue;
+    model_->endValue = params.endValue;
+
+    if (!model_->interf()) {
+        return false;
+    }
+
+    // rknn_lite 的后处理以 [x1, y1, x2, y2, score, class_id, 附加数值...] 输出，在此一次性转为按列存储
+    output.clear();
+    output.reserve(model_->results_vector.size());
+    output.keypointStride = keypointStride_;
+    for (const auto& item : model_->results_vector) {
+        double fields[6] = {0, 0, 0, 0, 0, 0};
+        for (size_t i = 0; i < 6 && i < item.size(); ++i) {
+            fields[i] = numericValue(item[i]);
+        }
+        // 坐标保留后处理给出的小数，与原先直接序列化 results_vector 的输出一致
+        output.addDetection(static_cast<float>(fields[0]), static_cast<float>(fields[1]),
+                            static_cast<float>(fields[2]), static_cast<float>(fields[3]),
+                            static_cast<float>(fields[4]), static_cast<int>(std::lround(fields[5])));
+        for (size_t i = 6; i < item.size(); ++i) {
+            output.addKeypoint(static_cast<float>(numericValue(item[i])));
+        }
+    }
+
+    if (resized) {
+        output.scaleBoxes(static_cast<double>(image.cols) / inputSize_.width,
+                          static_cast<double>(image.rows) / inputSize_.height);
+    }
+
+    // 交换而非移动：引擎拿回 output 中已清空但保留容量的容器
+    output.plateResults.swap(model_->plateResults);
+    output.value = model_->value;
+    return true;
+}
+
+void RknnInferenceEngine::releaseResources() {
+    // 输入图像属于请求，只解除引用；结果容器保留容量供下次请求复用
+    model_->ori_img.release();
+    model_->results_vector.clear();
+    model_->plateResults.clear();
+}
+
+void RknnInferenceEngine::trimResources() {
+    inputBuffer_.release();
+    decltype(model_->results_vector)().swap(model_->results_vector);
+    decltype(model_->plateResults)().swap(model_->plateResults);
+}
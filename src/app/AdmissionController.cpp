@@ -0,0 +1,128 @@
+//
+// Created by YJK on 2026/10/16.
+//
+
+#include "app/AdmissionController.h"
+#include <algorithm>
+#include <limits>
+
+int AdmissionController::Permit::remainingMs() const {
+    auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline_ - Clock::now()).count();
+    if (remaining <= 0) {
+        return 0;
+    }
+    return static_cast<int>(std::min<long long>(remaining, std::numeric_limits<int>::max()));
+}
+
+int AdmissionController::Permit::boundTimeout(int timeoutMs) const {
+    int remaining = remainingMs();
+    if (timeoutMs <= 0) {
+        return remaining;
+    }
+    return std::min(timeoutMs, remaining);
+}
+
+void AdmissionController::Permit::release() {
+    if (controller_ && status_ == Status::ADMITTED) {
+        controller_->release();
+    }
+    controller_ = nullptr;
+}
+
+AdmissionController::AdmissionController(int maxConcurrent, int maxQueued)
+        : maxConcurrent_(maxConcurrent),
+          maxQueued_(std::max(0, maxQueued)) {}
+
+AdmissionController::Permit AdmissionController::admit(Clock::time_point deadline) {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    if (shutdown_) {
+        return Permit(this, Status::SHUTDOWN, deadline);
+    }
+
+    if (Clock::now() >= deadline) {
+        timedOutRequests_++;
+        return Permit(this, Status::DEADLINE_EXCEEDED, deadline);
+    }
+
+    // 快速路径：有空闲名额且没有更早的排队者
+    if (maxConcurrent_ <= 0 || (active_ < maxConcurrent_ && queued_ == 0)) {
+        active_++;
+        admittedRequests_++;
+        return Permit(this, Status::ADMITTED, deadline);
+    }
+
+    // 等待队列已满，立即拒绝
+    if (queued_ >= maxQueued_) {
+        rejectedRequests_++;
+        return Permit(this, Status::QUEUE_FULL, deadline);
+    }
+
+    queued_++;
+    bool ready = condition_.wait_until(lock, deadline, [this] {
+        return shutdown_ || active_ < maxConcurrent_;
+    });
+    queued_--;
+
+    if (shutdown_) {
+        return Permit(this, Status::SHUTDOWN, deadline);
+    }
+
+    if (!ready) {
+        timedOutRequests_++;
+        return Permit(this, Status::DEADLINE_EXCEEDED, deadline);
+    }
+
+    active_++;
+    admittedRequests_++;
+    return Permit(this, Status::ADMITTED, deadline);
+}
+
+void AdmissionController::release() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        active_--;
+        if (queued_ == 0) {
+            return;
+        }
+    }
+    condition_.notify_one();
+}
+
+void AdmissionController::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shutdown_ = true;
+    }
+    condition_.notify_all();
+}
+
+const char* AdmissionController::statusToString(Status status) {
+    switch (status) {
+        case Status::ADMITTED:
+            return "admitted";
+        case Status::QUEUE_FULL:
+            return "server is overloaded, request queue is full";
+        case Status::DEADLINE_EXCEEDED:
+            return "request deadline exceeded while waiting for admission";
+        case Status::SHUTDOWN:
+            return "server is shutting down";
+    }
+    return "unknown";
+}
+
+AdmissionController::Stats AdmissionController::getStats() const {
+    Stats stats;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats.active = active_;
+        stats.queued = queued_;
+    }
+    stats.maxConcurrent = maxConcurrent_;
+    stats.maxQueued = maxQueued_;
+    stats.admitted = admittedRequests_.load();
+    stats.rejected = rejectedRequests_.load();
+    stats.timedOut = timedOutRequests_.load();
+    stats.expired = expiredRequests_.load();
+    return stats;
+}
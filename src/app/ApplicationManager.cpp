@@ -12,6 +12,12 @@
 #include "grpc/base/GrpcServiceRegistry.h"
 #include "grpc/base/GrpcServiceFactory.h"
 #include "AIService/ModelPool.h"
+#include "AIService/engine/InferenceEngineFactory.h"
+#include "common/base64_simd.h"
+#include "common/FramePool.h"
+#include <algorithm>
+#include <cstdio>
+#include <thread>
 
 // 初始化静态成员
 ApplicationManager* ApplicationManager::instance = nullptr;
@@ -88,16 +94,50 @@ bool ApplicationManager::initialize(const std::string& configPath) {
     // 加载并发配置
     const auto& config = AppConfig::getConcurrencyConfig();
     concurrencyConfig_.maxConcurrentRequests = config.maxConcurrentRequests;
+    concurrencyConfig_.maxQueuedRequests = config.maxQueuedRequests;
     concurrencyConfig_.modelPoolSize = config.modelPoolSize;
     concurrencyConfig_.requestTimeoutMs = config.requestTimeoutMs;
     concurrencyConfig_.modelAcquireTimeoutMs = config.modelAcquireTimeoutMs;
     concurrencyConfig_.enableConcurrencyMonitoring = config.enableConcurrencyMonitoring;
+    concurrencyConfig_.poolSpinIterations = config.poolSpinIterations;
+    concurrencyConfig_.poolThreadAffinity = config.poolThreadAffinity;
+    concurrencyConfig_.batchMaxSize = config.batchMaxSize;
+    concurrencyConfig_.batchMaxWaitMs = config.batchMaxWaitMs;
+    concurrencyConfig_.poolAutoscale = config.poolAutoscale;
+    concurrencyConfig_.poolScaleUpWaitMs = std::max(1, config.poolScaleUpWaitMs);
+    concurrencyConfig_.poolScaleDownIdleMs = std::max(1000, config.poolScaleDownIdleMs);
+    concurrencyConfig_.poolScaleIntervalMs = std::max(100, config.poolScaleIntervalMs);
+    concurrencyConfig_.poolTrimIdleMs = std::max(0, config.poolTrimIdleMs);
+    concurrencyConfig_.framePoolMaxCachedMb = std::max(0, config.framePoolMaxCachedMb);
+    concurrencyConfig_.pipelineEnabled = config.pipelineEnabled;
+    concurrencyConfig_.pipelineDecodeThreads = config.pipelineDecodeThreads > 0 ? config.pipelineDecodeThreads
+            : std::max(1, static_cast<int>(std::thread::hardware_concurrency() / 2));
+    concurrencyConfig_.pipelineSerializeThreads = std::max(1, config.pipelineSerializeThreads);
+    concurrencyConfig_.pipelineQueueDepth = std::max(1, config.pipelineQueueDepth);
+
+    // 解码缓冲池：设置缓存上限并按配置预分配
+    auto& framePool = FramePool::getInstance();
+    framePool.configure(static_cast<size_t>(concurrencyConfig_.framePoolMaxCachedMb) * 1024 * 1024);
+    for (const auto& item : config.framePoolPreallocate) {
+        int width = 0;
+        int height = 0;
+        if (std::sscanf(item.first.c_str(), "%dx%d", &width, &height) != 2 || item.second <= 0) {
+            LOGGER_WARNING_F("Ignoring invalid frame_pool_preallocate entry: {}", item.first);
+            continue;
+        }
+        size_t added = framePool.preallocate(width, height, static_cast<size_t>(item.second));
+        LOGGER_INFO_F("Frame pool preallocated {} of {} buffers for {}", added, item.second, item.first);
+    }
 
     LOGGER_INFO("Concurrency configuration loaded - max_concurrent: " +
                  std::to_string(concurrencyConfig_.maxConcurrentRequests) +
+                 ", max_queued: " + std::to_string(concurrencyConfig_.maxQueuedRequests) +
                  ", pool_size: " + std::to_string(concurrencyConfig_.modelPoolSize) +
                  ", acquire_timeout: " + std::to_string(concurrencyConfig_.modelAcquireTimeoutMs) + "ms");
 
+    // 初始化准入控制器
+    getAdmissionController();
+
     // 初始化并发监控器
     if (concurrencyConfig_.enableConcurrencyMonitoring) {
         httpMonitor_ = std::make_unique<ConcurrencyMonitor>();
@@ -118,6 +158,10 @@ bool ApplicationManager::initialize(const std::string& configPath) {
         LOGGER_WARNING("Model pool initialization failed, program will continue running...");
     }
 
+    if (concurrencyConfig_.pipelineEnabled && !initializePipeline()) {
+        LOGGER_WARNING("Inference pipeline initialization failed, requests will be processed on server threads");
+    }
+
     // 从注册表注册所有gRPC服务
     bool services_registered = registerGrpcServicesFromRegistry();
     if (!services_registered) {
@@ -160,6 +204,11 @@ void ApplicationManager::shutdown() {
 
     LOGGER_INFO("Shutting down application manager...");
 
+    // 拒绝新请求并唤醒排队中的请求
+    if (admissionController_) {
+        admissionController_->shutdown();
+    }
+
     // 停止HTTP服务器
     if (httpServer && httpServer->isRunning()) {
         LOGGER_INFO("Stopping HTTP server...");
@@ -172,9 +221,23 @@ void ApplicationManager::shutdown() {
         grpcServer->stop();
     }
 
+    // 停止流水线：处理完已入队的请求，推理阶段依赖模型池，须先于模型池关闭
+    if (pipeline_) {
+        pipeline_->stop();
+        pipeline_.reset();
+    }
+
     // 关闭所有模型池
     {
         std::unique_lock<std::shared_mutex> lock(modelPoolsMutex_);
+        // 先停止批处理调度器，它们持有模型池的引用
+        for (auto& pair : batchSchedulers_) {
+            if (pair.second) {
+                pair.second->stop();
+            }
+        }
+        batchSchedulers_.clear();
+
         LOGGER_INFO("Shutting down " + std::to_string(modelPools_.size()) + " model pools...");
 
         for (auto& pair : modelPools_) {
@@ -220,6 +283,10 @@ const HTTPServerConfig& ApplicationManager::getHTTPServerConfig() const {
     return AppConfig::getHTTPServerConfig();
 }
 
+const GRPCServerConfig& ApplicationManager::getGRPCServerConfig() const {
+    return AppConfig::getGRPCServerConfig();
+}
+
 bool ApplicationManager::initializeModelPools() {
     LOGGER_INFO("Starting model pool initialization...");
 
@@ -235,6 +302,7 @@ bool ApplicationManager::initializeModelPools() {
     std::unique_lock<std::shared_mutex> lock(modelPoolsMutex_);
 
     // 清理现有模型池
+    batchSchedulers_.clear();
     modelPools_.clear();
 
     LOGGER_INFO("Found " + std::to_string(modelConfigs.size()) +
@@ -255,13 +323,20 @@ bool ApplicationManager::initializeModelPools() {
                         throw ModelException("Model path is empty", config.name);
                     }
 
-                    // 检查模型文件是否存在
-                    std::ifstream modelFile(config.model_path);
-                    if (!modelFile.good()) {
-                        throw ModelException("Model file does not exist or cannot be accessed: " +
-                                             config.model_path, config.name);
+                    // 验证推理后端
+                    if (!InferenceEngineFactory::hasBackend(config.backend)) {
+                        throw ModelException("Unsupported inference backend: " + config.backend, config.name);
+                    }
+
+                    // 检查模型文件是否存在（CPU参考后端不需要模型文件）
+                    if (InferenceEngineFactory::requiresModelFile(config.backend)) {
+                        std::ifstream modelFile(config.model_path);
+                        if (!modelFile.good()) {
+                            throw ModelException("Model file does not exist or cannot be accessed: " +
+                                                 config.model_path, config.name);
+                        }
+                        modelFile.close();
                     }
-                    modelFile.close();
 
                     // 验证模型类型
                     if (config.model_type <= 0) {
@@ -285,19 +360,76 @@ bool ApplicationManager::initializeModelPools() {
                         return;
                     }
 
-                    // 创建模型池
-                    auto pool = std::make_unique<ModelPool>(concurrencyConfig_.modelPoolSize);
+                    // 创建模型池：model 条目中的 pool_size / batch_size / max_queue 优先于全局并发配置
+                    int poolSize = config.poolSize > 0 ? config.poolSize : concurrencyConfig_.modelPoolSize;
+                    int batchSize = config.batchSize > 0 ? config.batchSize : concurrencyConfig_.batchMaxSize;
+                    size_t maxQueue = static_cast<size_t>(std::max(0, config.maxQueue));
+
+                    // 验证CPU亲和性：只有批处理调度线程或流水线推理线程专门执行该模型的推理，
+                    // 两者都未启用时推理在共享的请求线程上执行，无法按模型绑定
+                    if (!config.cpuAffinity.empty() && batchSize <= 1 && !concurrencyConfig_.pipelineEnabled) {
+                        throw ModelException("cpu_affinity requires batch_size > 1 or pipeline_enabled", config.name);
+                    }
+
+                    PoolOptions poolOptions;
+                    poolOptions.spinIterations = concurrencyConfig_.poolSpinIterations;
+                    poolOptions.threadAffinity = concurrencyConfig_.poolThreadAffinity;
+                    // 启用批处理时请求在调度器中排队，队列上限由调度器执行
+                    poolOptions.maxWaiters = batchSize > 1 ? 0 : maxQueue;
+                    poolOptions.trimIdleMs = concurrencyConfig_.poolTrimIdleMs;
+                    poolOptions.scaleIntervalMs = concurrencyConfig_.poolScaleIntervalMs;
+
+                    // 弹性伸缩：从下限个实例开始，按排队情况在 [min, max] 之间调整
+                    size_t initialInstances = static_cast<size_t>(std::max(1, poolSize));
+                    if (concurrencyConfig_.poolAutoscale) {
+                        int maxInstances = config.poolMaxInstances > 0 ? config.poolMaxInstances : poolSize;
+                        int minInstances = config.poolMinInstances > 0 ? config.poolMinInstances : 1;
+                        maxInstances = std::max(1, maxInstances);
+                        minInstances = std::max(1, std::min(minInstances, maxInstances));
+                        initialInstances = static_cast<size_t>(minInstances);
+                        poolOptions.minInstances = static_cast<size_t>(minInstances);
+                        poolOptions.maxInstances = static_cast<size_t>(maxInstances);
+                        poolOptions.scaleUpWaitMs = concurrencyConfig_.poolScaleUpWaitMs;
+                        poolOptions.scaleDownIdleMs = concurrencyConfig_.poolScaleDownIdleMs;
+                    }
 
-                    if (!pool->initialize(config.model_path, config.model_type, config.objectThresh)) {
+                    auto pool = std::make_unique<ModelPool>(initialInstances, poolOptions);
+
+                    EngineCreateInfo engineInfo;
+                    engineInfo.backend = config.backend;
+                    engineInfo.modelPath = config.model_path;
+                    engineInfo.modelType = config.model_type;
+                    engineInfo.threshold = config.objectThresh;
+                    engineInfo.cpuLatencyMs = config.cpuLatencyMs;
+                    engineInfo.cpuDetectionCount = config.cpuDetectionCount;
+                    engineInfo.npuCores = config.npuCores;
+                    engineInfo.inputWidth = std::max(0, config.inputWidth);
+                    engineInfo.inputHeight = std::max(0, config.inputHeight);
+                    engineInfo.keypointStride = config.keypointStride >= 2 ? config.keypointStride : 0;
+
+                    if (!pool->initialize(engineInfo)) {
                         throw ModelException("Failed to initialize model pool", config.name);
                     }
 
+                    // 启用动态批处理时，每个实例（弹性伸缩时按最大实例数）对应一个调度线程
+                    if (batchSize > 1) {
+                        auto scheduler = std::make_unique<BatchScheduler>(
+                                *pool, static_cast<size_t>(batchSize), concurrencyConfig_.batchMaxWaitMs, maxQueue);
+                        scheduler->start(pool->getCapacity(), config.cpuAffinity);
+                        batchSchedulers_[config.model_type] = std::move(scheduler);
+                    }
+
+                    std::string elasticInfo = pool->isElastic() ?
+                                              ", up to " + std::to_string(pool->getCapacity()) : std::string();
+
                     // 存储模型池
                     modelPools_[config.model_type] = std::move(pool);
 
                     LOGGER_INFO("Model pool initialized successfully: " + config.name +
                                  " (type: " + std::to_string(config.model_type) + ") with " +
-                                 std::to_string(concurrencyConfig_.modelPoolSize) + " instances");
+                                 std::to_string(initialInstances) + " instances" + elasticInfo +
+                                 (batchSize > 1 ? ", batch size " + std::to_string(batchSize) : std::string()) +
+                                 (maxQueue > 0 ? ", max queue " + std::to_string(maxQueue) : std::string()));
                 }
         );
 
@@ -334,19 +466,19 @@ GrpcServer* ApplicationManager::getGrpcServer() const {
 // 模型池访问方法实现
 bool ApplicationManager::executeModelInference(int modelType,
                                                const cv::Mat& imageData,
-                                               std::vector<std::vector<std::any>>& results,
-                                               std::vector<std::string>& plateResults,
+                                               InferenceOutput& output,
                                                double startValue,
                                                double endValue,
-                                               double& targetResult,
-                                               int timeoutMs) {
+                                               int timeoutMs,
+                                               const AcquirePriority& priority,
+                                               StageTimings* timings) {
 
     if (timeoutMs <= 0) {
         timeoutMs = concurrencyConfig_.modelAcquireTimeoutMs;
     }
 
-    LOGGER_DEBUG("Executing model inference for type: " + std::to_string(modelType) +
-                  ", timeout: " + std::to_string(timeoutMs) + "ms");
+    LOGGER_DEBUG_F("Executing model inference for type: {}, timeout: {}ms, priority: {}",
+                   modelType, timeoutMs, priority.priority);
 
     std::shared_lock<std::shared_mutex> lock(modelPoolsMutex_);
 
@@ -361,16 +493,41 @@ bool ApplicationManager::executeModelInference(int modelType,
         return false;
     }
 
+    auto schedulerIt = batchSchedulers_.find(modelType);
+    BatchScheduler* scheduler = schedulerIt != batchSchedulers_.end() ? schedulerIt->second.get() : nullptr;
+
     lock.unlock(); // 释放读锁
 
-    // 记录模型池状态
-    auto poolStatus = poolIt->second->getStatus();
-    LOGGER_DEBUG("Model pool status for type " + std::to_string(modelType) +
-                  " - available: " + std::to_string(poolStatus.availableModels) +
-                  "/" + std::to_string(poolStatus.totalModels));
+    InferenceParams params;
+    params.startValue = startValue;
+    params.endValue = endValue;
+
+    if (scheduler) {
+        // 经批处理调度器合并后推理
+        if (!scheduler->submit(imageData, params, output, timeoutMs, priority, timings)) {
+            LOGGER_ERROR("Batched model inference failed or timed out (" +
+                          std::to_string(timeoutMs) + "ms) for type: " + std::to_string(modelType));
+            return false;
+        }
+        auto collectStart = std::chrono::steady_clock::now();
+        bool collected = collectInferenceOutput(modelType, output);
+        if (timings) {
+            timings->mark(LatencyStage::POSTPROCESS, collectStart);
+        }
+        return collected;
+    }
+
+    // 记录模型池状态（getStatus 需要汇总各实例统计，只在调试日志开启时调用）
+    if (Logger::isEnabled(LogLevel::DEBUG)) {
+        auto poolStatus = poolIt->second->getStatus();
+        LOGGER_DEBUG_F("Model pool status for type {} - available: {}/{}",
+                       modelType, poolStatus.availableModels, poolStatus.totalModels);
+    }
 
     // 使用RAII获取模型
-    ModelAcquirer acquirer(*poolIt->second, timeoutMs);
+    auto acquireStart = std::chrono::steady_clock::now();
+    ModelAcquirer acquirer(*poolIt->second, timeoutMs, priority);
+    auto inferenceStart = std::chrono::steady_clock::now();
 
     if (!acquirer.isValid()) {
         LOGGER_ERROR("Failed to acquire model from pool within timeout (" +
@@ -380,41 +537,21 @@ bool ApplicationManager::executeModelInference(int modelType,
 
     try {
         // 安全地使用模型进行推理
-        acquirer->ori_img = imageData;
-
-        acquirer->startValue = startValue;
-        acquirer->endValue = endValue;
-
-        LOGGER_DEBUG("Starting model inference for type: " + std::to_string(modelType));
+        LOGGER_DEBUG_F("Starting model inference for type: {}, backend: {}", modelType, acquirer->getBackendName());
 
-        if (!acquirer->interf()) {
+        if (!acquirer->infer(imageData, params, output)) {
             LOGGER_ERROR("Model inference failed for type: " + std::to_string(modelType));
             return false;
         }
+        auto collectStart = std::chrono::steady_clock::now();
 
-        // 获取结果
-//        results = acquirer->results_vector;
-        results = std::move(acquirer->results_vector);
-
-        if (modelType == 4) {
-            plateResults = acquirer->plateResults;
-            LOGGER_DEBUG("Retrieved " + std::to_string(plateResults.size()) + " plate results");
-        } else if (modelType == 5) {
-            targetResult = acquirer->value;
-        }
-
-        // 清空原始向量以释放内存
-        acquirer->results_vector.clear();
-        acquirer->results_vector.shrink_to_fit();
-
-        if (modelType == 4) {
-            acquirer->plateResults.clear();
-            acquirer->plateResults.shrink_to_fit();
+        bool collected = collectInferenceOutput(modelType, output);
+        if (timings) {
+            timings->set(LatencyStage::POOL_WAIT, acquireStart, inferenceStart);
+            timings->set(LatencyStage::INFERENCE, inferenceStart, collectStart);
+            timings->mark(LatencyStage::POSTPROCESS, collectStart);
         }
-
-        LOGGER_DEBUG("Model inference completed successfully for type: " +
-                      std::to_string(modelType) + ", results count: " + std::to_string(results.size()));
-        return true;
+        return collected;
 
     } catch (const std::exception& e) {
         LOGGER_ERROR("Model inference exception for type " + std::to_string(modelType) +
@@ -423,6 +560,22 @@ bool ApplicationManager::executeModelInference(int modelType,
     }
 }
 
+bool ApplicationManager::collectInferenceOutput(int modelType, InferenceOutput& output) {
+    if (modelType == 4) {
+        LOGGER_DEBUG_F("Retrieved {} plate results", output.plateResults.size());
+    } else {
+        output.plateResults.clear();
+    }
+
+    if (modelType != 5) {
+        output.value = 0.0;
+    }
+
+    LOGGER_DEBUG_F("Model inference completed successfully for type: {}, results count: {}",
+                   modelType, output.size());
+    return true;
+}
+
 bool ApplicationManager::setModelEnabled(int modelType, bool enabled) {
     std::shared_lock<std::shared_mutex> lock(modelPoolsMutex_);
 
@@ -455,7 +608,7 @@ ModelPool::PoolStatus ApplicationManager::getModelPoolStatus(int modelType) cons
     auto poolIt = modelPools_.find(modelType);
     if (poolIt == modelPools_.end()) {
         // 返回默认状态
-        ModelPool::PoolStatus defaultStatus;
+        ModelPool::PoolStatus defaultStatus{};
         defaultStatus.totalModels = 0;
         defaultStatus.availableModels = 0;
         defaultStatus.busyModels = 0;
@@ -467,6 +620,16 @@ ModelPool::PoolStatus ApplicationManager::getModelPoolStatus(int modelType) cons
     return poolIt->second->getStatus();
 }
 
+cv::Size ApplicationManager::getModelInputSize(int modelType) const {
+    std::shared_lock<std::shared_mutex> lock(modelPoolsMutex_);
+
+    auto poolIt = modelPools_.find(modelType);
+    if (poolIt == modelPools_.end()) {
+        return cv::Size();
+    }
+    return poolIt->second->getInputSize();
+}
+
 std::unordered_map<int, ModelPool::PoolStatus> ApplicationManager::getAllModelPoolStatus() const {
     std::shared_lock<std::shared_mutex> lock(modelPoolsMutex_);
 
@@ -478,6 +641,17 @@ std::unordered_map<int, ModelPool::PoolStatus> ApplicationManager::getAllModelPo
     return statusMap;
 }
 
+std::unordered_map<int, BatchScheduler::Stats> ApplicationManager::getAllBatchSchedulerStats() const {
+    std::shared_lock<std::shared_mutex> lock(modelPoolsMutex_);
+
+    std::unordered_map<int, BatchScheduler::Stats> statsMap;
+    for (const auto& pair : batchSchedulers_) {
+        statsMap[pair.first] = pair.second->getStats();
+    }
+
+    return statsMap;
+}
+
 // 并发监控方法实现
 void ApplicationManager::startHttpRequest() {
     if (httpMonitor_ && concurrencyConfig_.enableConcurrencyMonitoring) {
@@ -531,6 +705,56 @@ ConcurrencyMonitor::Stats ApplicationManager::getGrpcConcurrencyStats() const {
     return ConcurrencyMonitor::Stats{0, 0, 0, 0.0};
 }
 
+std::vector<ConcurrencyMonitor::LatencyStats> ApplicationManager::getHttpLatencyStats() const {
+    if (httpMonitor_) {
+        return httpMonitor_->getLatencyStats();
+    }
+    return {};
+}
+
+std::vector<ConcurrencyMonitor::LatencyStats> ApplicationManager::getGrpcLatencyStats() const {
+    if (grpcMonitor_) {
+        return grpcMonitor_->getLatencyStats();
+    }
+    return {};
+}
+
+void ApplicationManager::recordHttpLatency(int modelType, const StageTimings& timings) {
+    if (httpMonitor_ && concurrencyConfig_.enableConcurrencyMonitoring) {
+        httpMonitor_->recordLatency(modelType, timings);
+    }
+}
+
+void ApplicationManager::recordGrpcLatency(int modelType, const StageTimings& timings) {
+    if (grpcMonitor_ && concurrencyConfig_.enableConcurrencyMonitoring) {
+        grpcMonitor_->recordLatency(modelType, timings);
+    }
+}
+
+AdmissionController::Permit ApplicationManager::admitRequest(int budgetMs) {
+    int timeoutMs = concurrencyConfig_.requestTimeoutMs;
+    if (budgetMs > 0 && (timeoutMs <= 0 || budgetMs < timeoutMs)) {
+        timeoutMs = budgetMs;
+    }
+
+    auto deadline = timeoutMs > 0
+                    ? AdmissionController::Clock::now() + std::chrono::milliseconds(timeoutMs)
+                    : AdmissionController::Clock::time_point::max();
+
+    return getAdmissionController().admit(deadline);
+}
+
+AdmissionController& ApplicationManager::getAdmissionController() {
+    // 未经 initialize() 时（如单独使用处理函数）按配置默认值创建
+    std::call_once(admissionInitFlag_, [this] {
+        if (!admissionController_) {
+            admissionController_ = std::make_unique<AdmissionController>(concurrencyConfig_.maxConcurrentRequests,
+                                                                         concurrencyConfig_.maxQueuedRequests);
+        }
+    });
+    return *admissionController_;
+}
+
 const ConcurrencyConfig& ApplicationManager::getConcurrencyConfig() const {
     return concurrencyConfig_;
 }
@@ -602,13 +826,59 @@ bool ApplicationManager::registerGrpcServicesFromRegistry() {
     });
 }
 
+bool ApplicationManager::initializePipeline() {
+    return ExceptionHandler::execute("Initializing inference pipeline", [&]() {
+        InferencePipeline::Options options;
+        options.decodeThreads = static_cast<size_t>(concurrencyConfig_.pipelineDecodeThreads);
+        options.serializeThreads = static_cast<size_t>(concurrencyConfig_.pipelineSerializeThreads);
+        options.queueDepth = static_cast<size_t>(concurrencyConfig_.pipelineQueueDepth);
+
+        auto pipeline = std::make_unique<InferencePipeline>(options,
+                [this](int modelType, const cv::Mat& image, const InferenceParams& params, int timeoutMs,
+                       const AcquirePriority& priority, StageTimings* timings, InferenceOutput& output) {
+                    return executeModelInference(modelType, image, output, params.startValue, params.endValue,
+                                                 timeoutMs, priority, timings);
+                });
+
+        // 每个模型的推理线程数与可同时执行的推理数一致；批处理时还需足够的提交者凑满批次。
+        // 不批处理时推理就在这些线程上执行，按模型的 cpu_affinity 绑定（批处理时绑定的是调度线程）
+        {
+            const auto& modelConfigs = AppConfig::getModelConfigs();
+            std::shared_lock<std::shared_mutex> lock(modelPoolsMutex_);
+            for (const auto& pair : modelPools_) {
+                size_t workers = pair.second->getCapacity();
+                std::vector<int> cpuAffinity;
+                auto schedulerIt = batchSchedulers_.find(pair.first);
+                if (schedulerIt != batchSchedulers_.end()) {
+                    workers *= schedulerIt->second->getStats().maxBatchSize;
+                } else {
+                    auto configIt = std::find_if(modelConfigs.begin(), modelConfigs.end(),
+                                                 [&pair](const ModelConfig& config) {
+                                                     return config.model_type == pair.first;
+                                                 });
+                    if (configIt != modelConfigs.end()) {
+                        cpuAffinity = configIt->cpuAffinity;
+                    }
+                }
+                pipeline->addModel(pair.first, workers, cpuAffinity);
+            }
+        }
+
+        pipeline->start();
+        pipeline_ = std::move(pipeline);
+    });
+}
+
 bool ApplicationManager::initializeGrpcServer() {
     return ExceptionHandler::execute("Initializing gRPC server", [&]() {
         std::string grpcAddress = getGrpcServerAddress();
         LOGGER_INFO("Initializing gRPC server, address: " + grpcAddress);
 
         // 创建gRPC服务器
-        grpcServer = std::make_unique<GrpcServer>(grpcAddress);
+        const auto& grpcConfig = getGRPCServerConfig();
+        grpcServer = std::make_unique<GrpcServer>(grpcAddress,
+                                                  GrpcServer::compressionFromString(grpcConfig.compression),
+                                                  grpcConfig.asyncPollThreads);
 
         // 初始化注册的服务
         if (!initializeGrpcServices()) {
@@ -676,6 +946,10 @@ void ApplicationManager::logInitializationSummary() {
         // 统计路由数量
         const auto& routes = httpServer->getRoutes();
         LOGGER_INFO("  - Routes registered: " + std::to_string(routes.size()));
+
+        auto connectionStats = httpServer->getConnectionStats();
+        LOGGER_INFO("  - Worker threads: " + std::to_string(connectionStats.threads) +
+                     ", max queued connections: " + std::to_string(connectionStats.maxQueued));
     } else {
         LOGGER_INFO("✗ HTTP Server: Not running");
     }
@@ -696,17 +970,53 @@ void ApplicationManager::logInitializationSummary() {
         for (const auto& pair : modelPools_) {
             auto status = pair.second->getStatus();
             LOGGER_INFO("  - Type " + std::to_string(pair.first) + ": " +
-                         std::to_string(status.totalModels) + " instances, " +
+                         std::to_string(status.totalModels) + " instances" +
+                         (status.elastic ? " (" + std::to_string(status.minInstances) + "-" +
+                                           std::to_string(status.maxInstances) + ")" : std::string()) + ", " +
                          (status.isEnabled ? "enabled" : "disabled"));
         }
     }
 
     // 并发配置
     LOGGER_INFO("✓ Concurrency Config:");
-    LOGGER_INFO("  - Max concurrent requests: " + std::to_string(concurrencyConfig_.maxConcurrentRequests));
-    LOGGER_INFO("  - Model pool size: " + std::to_string(concurrencyConfig_.modelPoolSize));
+    LOGGER_INFO("  - Max concurrent requests: " + std::to_string(concurrencyConfig_.maxConcurrentRequests) +
+                 ", max queued requests: " + std::to_string(concurrencyConfig_.maxQueuedRequests));
+    LOGGER_INFO("  - Default model pool size: " + std::to_string(concurrencyConfig_.modelPoolSize));
     LOGGER_INFO("  - Model acquire timeout: " + std::to_string(concurrencyConfig_.modelAcquireTimeoutMs) + "ms");
+    LOGGER_INFO("  - Pool spin iterations: " + std::to_string(concurrencyConfig_.poolSpinIterations) +
+                 ", thread affinity: " + (concurrencyConfig_.poolThreadAffinity ? "enabled" : "disabled"));
+    if (concurrencyConfig_.poolAutoscale) {
+        LOGGER_INFO("  - Pool autoscale: scale up when acquire wait p95 > " +
+                     std::to_string(concurrencyConfig_.poolScaleUpWaitMs) + "ms, scale down after " +
+                     std::to_string(concurrencyConfig_.poolScaleDownIdleMs) + "ms of spare capacity");
+    } else {
+        LOGGER_INFO("  - Pool autoscale: disabled");
+    }
+    if (concurrencyConfig_.poolTrimIdleMs > 0) {
+        LOGGER_INFO("  - Pool working set trim after " + std::to_string(concurrencyConfig_.poolTrimIdleMs) + "ms idle");
+    } else {
+        LOGGER_INFO("  - Pool working set trim: disabled");
+    }
+    if (pipeline_) {
+        LOGGER_INFO("  - Inference pipeline: " + std::to_string(concurrencyConfig_.pipelineDecodeThreads) +
+                     " decode threads, " + std::to_string(concurrencyConfig_.pipelineSerializeThreads) +
+                     " serialize threads, queue depth " + std::to_string(concurrencyConfig_.pipelineQueueDepth));
+    } else {
+        LOGGER_INFO("  - Inference pipeline: disabled");
+    }
+    if (concurrencyConfig_.framePoolMaxCachedMb > 0) {
+        LOGGER_INFO("  - Frame buffer pool: up to " + std::to_string(concurrencyConfig_.framePoolMaxCachedMb) + "MB cached");
+    } else {
+        LOGGER_INFO("  - Frame buffer pool: disabled");
+    }
+    if (concurrencyConfig_.batchMaxSize > 1) {
+        LOGGER_INFO("  - Dynamic batching: default max size " + std::to_string(concurrencyConfig_.batchMaxSize) +
+                     ", max wait " + std::to_string(concurrencyConfig_.batchMaxWaitMs) + "ms");
+    } else {
+        LOGGER_INFO("  - Dynamic batching: disabled");
+    }
     LOGGER_INFO("  - Monitoring: " + std::string(concurrencyConfig_.enableConcurrencyMonitoring ? "enabled" : "disabled"));
+    LOGGER_INFO("  - Base64 codec: " + std::string(base64_simd::implementationName()));
 
     LOGGER_INFO("=== Initialization Summary End ===");
 }
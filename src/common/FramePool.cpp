@@ -0,0 +1,380 @@
+//
+// Created by YJK on 2026/10/16.
+//
+
+#include "common/FramePool.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+namespace {
+
+    // 对齐分配（MSVCRT/UCRT 没有 aligned_alloc，须配对使用 _aligned_malloc/_aligned_free）
+    unsigned char* alignedAlloc(size_t alignment, size_t bytes) {
+#ifdef _WIN32
+        return static_cast<unsigned char*>(_aligned_malloc(bytes, alignment));
+#else
+        return static_cast<unsigned char*>(std::aligned_alloc(alignment, bytes));
+#endif
+    }
+
+    void alignedFree(unsigned char* buffer) {
+#ifdef _WIN32
+        _aligned_free(buffer);
+#else
+        std::free(buffer);
+#endif
+    }
+
+    // 分档按常见相机分辨率，字节数为 BGR 三通道
+    constexpr int SIZE_CLASS_DIMS[][2] = {
+            {320, 240},
+            {640, 480},
+            {1280, 720},
+            {1920, 1080},
+            {2560, 1440},
+            {3840, 2160}
+    };
+
+    uint32_t readBigEndian16(const unsigned char* p) {
+        return (static_cast<uint32_t>(p[0]) << 8) | p[1];
+    }
+
+    uint32_t readBigEndian32(const unsigned char* p) {
+        return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+               (static_cast<uint32_t>(p[2]) << 8) | p[3];
+    }
+
+    bool peekJpegSize(const unsigned char* data, size_t size, int& width, int& height) {
+        size_t pos = 2;
+        while (pos + 4 <= size) {
+            if (data[pos] != 0xFF) {
+                return false;
+            }
+            unsigned char marker = data[pos + 1];
+            if (marker == 0xFF) {
+                // 段之间允许填充字节
+                ++pos;
+                continue;
+            }
+            pos += 2;
+
+            // 无长度字段的独立标记
+            if (marker == 0x01 || (marker >= 0xD0 && marker <= 0xD8)) {
+                continue;
+            }
+            // 到达扫描数据或结束仍未见到帧头
+            if (marker == 0xD9 || marker == 0xDA) {
+                return false;
+            }
+
+            uint32_t length = readBigEndian16(data + pos);
+            if (length < 2) {
+                return false;
+            }
+
+            // SOF0~SOF15，排除 DHT(C4)、JPG(C8)、DAC(CC)
+            bool isFrameHeader = marker >= 0xC0 && marker <= 0xCF &&
+                                 marker != 0xC4 && marker != 0xC8 && marker != 0xCC;
+            if (isFrameHeader) {
+                if (pos + 7 > size) {
+                    return false;
+                }
+                height = static_cast<int>(readBigEndian16(data + pos + 3));
+                width = static_cast<int>(readBigEndian16(data + pos + 5));
+                return width > 0 && height > 0;
+            }
+            pos += length;
+        }
+        return false;
+    }
+
+    bool peekPngSize(const unsigned char* data, size_t size, int& width, int& height) {
+        // 8字节签名后紧跟 IHDR 块：长度(4) + "IHDR"(4) + 宽(4) + 高(4)
+        if (size < 24 || std::memcmp(data + 12, "IHDR", 4) != 0) {
+            return false;
+        }
+        uint32_t w = readBigEndian32(data + 16);
+        uint32_t h = readBigEndian32(data + 20);
+        if (w == 0 || h == 0 || w > (1u << 16) || h > (1u << 16)) {
+            return false;
+        }
+        width = static_cast<int>(w);
+        height = static_cast<int>(h);
+        return true;
+    }
+
+} // namespace
+
+FramePool::Frame::Frame(Frame&& other) noexcept
+        : image_(std::move(other.image_)), buffer_(other.buffer_), sizeClass_(other.sizeClass_),
+          originalSize_(other.originalSize_), reduced_(other.reduced_),
+          scaleX_(other.scaleX_), scaleY_(other.scaleY_) {
+    other.buffer_ = nullptr;
+    other.sizeClass_ = -1;
+}
+
+FramePool::Frame& FramePool::Frame::operator=(Frame&& other) noexcept {
+    if (this != &other) {
+        reset();
+        image_ = std::move(other.image_);
+        buffer_ = other.buffer_;
+        sizeClass_ = other.sizeClass_;
+        originalSize_ = other.originalSize_;
+        reduced_ = other.reduced_;
+        scaleX_ = other.scaleX_;
+        scaleY_ = other.scaleY_;
+        other.buffer_ = nullptr;
+        other.sizeClass_ = -1;
+    }
+    return *this;
+}
+
+void FramePool::Frame::reset() {
+    // 先释放Mat头（外部数据，不会释放内存），再归还缓冲区
+    image_.release();
+    originalSize_ = cv::Size();
+    reduced_ = false;
+    scaleX_ = 1.0;
+    scaleY_ = 1.0;
+    if (buffer_ != nullptr) {
+        auto& pool = FramePool::getInstance();
+        pool.leasedBuffers_.fetch_sub(1, std::memory_order_relaxed);
+        pool.releaseBuffer(sizeClass_, buffer_);
+        buffer_ = nullptr;
+        sizeClass_ = -1;
+    }
+}
+
+FramePool& FramePool::getInstance() {
+    // 不析构：租约可能在静态对象析构阶段才归还
+    static FramePool* instance = new FramePool();
+    return *instance;
+}
+
+FramePool::FramePool() {
+    for (size_t i = 0; i < SIZE_CLASS_COUNT; ++i) {
+        auto& sizeClass = classes_[i];
+        sizeClass.width = SIZE_CLASS_DIMS[i][0];
+        sizeClass.height = SIZE_CLASS_DIMS[i][1];
+        size_t bytes = static_cast<size_t>(sizeClass.width) * sizeClass.height * 3;
+        sizeClass.bytes = (bytes + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    }
+}
+
+void FramePool::configure(size_t maxCachedBytes) {
+    maxCachedBytes_.store(maxCachedBytes, std::memory_order_relaxed);
+
+    // 上限调小时从大档位开始释放多余的缓存
+    for (size_t i = SIZE_CLASS_COUNT; i-- > 0 && cachedBytes_.load(std::memory_order_relaxed) > maxCachedBytes;) {
+        auto& sizeClass = classes_[i];
+        std::lock_guard<std::mutex> lock(sizeClass.mutex);
+        while (!sizeClass.freeBuffers.empty() && cachedBytes_.load(std::memory_order_relaxed) > maxCachedBytes) {
+            alignedFree(sizeClass.freeBuffers.back());
+            sizeClass.freeBuffers.pop_back();
+            cachedBytes_.fetch_sub(sizeClass.bytes, std::memory_order_relaxed);
+            cachedBuffers_.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+size_t FramePool::preallocate(int width, int height, size_t count) {
+    if (width <= 0 || height <= 0) {
+        return 0;
+    }
+    int index = sizeClassFor(static_cast<size_t>(width) * height * 3);
+    if (index < 0) {
+        return 0;
+    }
+
+    auto& sizeClass = classes_[index];
+    size_t added = 0;
+    for (; added < count; ++added) {
+        if (cachedBytes_.load(std::memory_order_relaxed) + sizeClass.bytes > maxCachedBytes_.load(std::memory_order_relaxed)) {
+            break;
+        }
+        auto* buffer = alignedAlloc(ALIGNMENT, sizeClass.bytes);
+        if (buffer == nullptr) {
+            break;
+        }
+        // 写一遍让页面真正映射进来
+        std::memset(buffer, 0, sizeClass.bytes);
+
+        std::lock_guard<std::mutex> lock(sizeClass.mutex);
+        sizeClass.freeBuffers.push_back(buffer);
+        cachedBytes_.fetch_add(sizeClass.bytes, std::memory_order_relaxed);
+        cachedBuffers_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return added;
+}
+
+bool FramePool::decode(const unsigned char* data, size_t size, int flags, Frame& frame,
+                       const cv::Size& targetSize) {
+    frame.reset();
+    cv::Mat encoded(1, static_cast<int>(size), CV_8UC1, const_cast<unsigned char*>(data));
+
+    int width = 0;
+    int height = 0;
+    bool sized = flags == cv::IMREAD_COLOR && peekImageSize(data, size, width, height);
+
+    // 只有JPEG能在解码时缩放（DCT缩放），其他格式解码后再缩放并不省时间
+    int scale = sized && data[0] == 0xFF ? reducedScale(width, height, targetSize) : 1;
+    int decodeFlags = flags;
+    if (scale == 8) {
+        decodeFlags = cv::IMREAD_REDUCED_COLOR_8;
+    } else if (scale == 4) {
+        decodeFlags = cv::IMREAD_REDUCED_COLOR_4;
+    } else if (scale == 2) {
+        decodeFlags = cv::IMREAD_REDUCED_COLOR_2;
+    }
+    // libjpeg 缩放后的尺寸向上取整
+    int decodedWidth = (width + scale - 1) / scale;
+    int decodedHeight = (height + scale - 1) / scale;
+
+    int index = -1;
+    bool enabled = maxCachedBytes_.load(std::memory_order_relaxed) > 0;
+    if (enabled && sized) {
+        index = sizeClassFor(static_cast<size_t>(decodedWidth) * decodedHeight * 3);
+    }
+
+    if (index < 0) {
+        if (enabled) {
+            unpooled_.fetch_add(1, std::memory_order_relaxed);
+        }
+        frame.image_ = cv::imdecode(encoded, decodeFlags);
+    } else {
+        // 目标Mat与解码结果尺寸、类型一致时 imdecode 直接写入，不再分配
+        unsigned char* buffer = acquireBuffer(index);
+        cv::Mat target(decodedHeight, decodedWidth, CV_8UC3, buffer);
+        cv::Mat decoded = cv::imdecode(encoded, decodeFlags, &target);
+        if (decoded.empty() || target.data != buffer) {
+            // 解码失败，或结果尺寸与头部不符（如EXIF旋转）时 imdecode 已另行分配
+            releaseBuffer(index, buffer);
+            if (!decoded.empty()) {
+                unpooled_.fetch_add(1, std::memory_order_relaxed);
+            }
+            frame.image_ = decoded;
+        } else {
+            leasedBuffers_.fetch_add(1, std::memory_order_relaxed);
+            frame.image_ = target;
+            frame.buffer_ = buffer;
+            frame.sizeClass_ = index;
+        }
+    }
+
+    if (frame.image_.empty()) {
+        return false;
+    }
+
+    frame.originalSize_ = frame.image_.size();
+    if (scale > 1) {
+        // EXIF旋转90°时解码结果宽高互换，原图尺寸随之互换
+        cv::Size original(width, height);
+        if (decodedWidth != decodedHeight && frame.image_.cols == decodedHeight && frame.image_.rows == decodedWidth) {
+            original = cv::Size(height, width);
+        }
+        frame.originalSize_ = original;
+        frame.reduced_ = true;
+        frame.scaleX_ = static_cast<double>(original.width) / frame.image_.cols;
+        frame.scaleY_ = static_cast<double>(original.height) / frame.image_.rows;
+        reduced_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+int FramePool::reducedScale(int width, int height, const cv::Size& targetSize) {
+    if (targetSize.width <= 0 || targetSize.height <= 0 || width <= 0 || height <= 0) {
+        return 1;
+    }
+    // 按比例缩放到输入尺寸时的缩小倍数
+    double ratio = std::max(static_cast<double>(width) / targetSize.width,
+                            static_cast<double>(height) / targetSize.height);
+    int scale = 1;
+    while (scale < 8 && scale * 2 <= ratio) {
+        scale *= 2;
+    }
+    return scale;
+}
+
+FramePool::Stats FramePool::getStats() const {
+    Stats stats;
+    stats.hits = hits_.load(std::memory_order_relaxed);
+    stats.misses = misses_.load(std::memory_order_relaxed);
+    stats.unpooled = unpooled_.load(std::memory_order_relaxed);
+    stats.evictions = evictions_.load(std::memory_order_relaxed);
+    stats.reduced = reduced_.load(std::memory_order_relaxed);
+    stats.cachedBuffers = cachedBuffers_.load(std::memory_order_relaxed);
+    stats.cachedBytes = cachedBytes_.load(std::memory_order_relaxed);
+    stats.maxCachedBytes = maxCachedBytes_.load(std::memory_order_relaxed);
+    stats.leasedBuffers = leasedBuffers_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+bool FramePool::peekImageSize(const unsigned char* data, size_t size, int& width, int& height) {
+    if (data == nullptr || size < 4) {
+        return false;
+    }
+    if (data[0] == 0xFF && data[1] == 0xD8) {
+        return peekJpegSize(data, size, width, height);
+    }
+    static const unsigned char PNG_SIGNATURE[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    if (size >= 8 && std::memcmp(data, PNG_SIGNATURE, 8) == 0) {
+        return peekPngSize(data, size, width, height);
+    }
+    return false;
+}
+
+int FramePool::sizeClassFor(size_t bytes) const {
+    for (size_t i = 0; i < SIZE_CLASS_COUNT; ++i) {
+        if (bytes <= classes_[i].bytes) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+unsigned char* FramePool::acquireBuffer(int index) {
+    auto& sizeClass = classes_[index];
+    {
+        std::lock_guard<std::mutex> lock(sizeClass.mutex);
+        if (!sizeClass.freeBuffers.empty()) {
+            unsigned char* buffer = sizeClass.freeBuffers.back();
+            sizeClass.freeBuffers.pop_back();
+            cachedBytes_.fetch_sub(sizeClass.bytes, std::memory_order_relaxed);
+            cachedBuffers_.fetch_sub(1, std::memory_order_relaxed);
+            hits_.fetch_add(1, std::memory_order_relaxed);
+            return buffer;
+        }
+    }
+
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    auto* buffer = alignedAlloc(ALIGNMENT, sizeClass.bytes);
+    if (buffer == nullptr) {
+        throw std::bad_alloc();
+    }
+    return buffer;
+}
+
+void FramePool::releaseBuffer(int index, unsigned char* buffer) {
+    auto& sizeClass = classes_[index];
+
+    // 占用缓存额度成功才放回，否则直接释放
+    size_t cached = cachedBytes_.load(std::memory_order_relaxed);
+    size_t limit = maxCachedBytes_.load(std::memory_order_relaxed);
+    do {
+        if (cached + sizeClass.bytes > limit) {
+            evictions_.fetch_add(1, std::memory_order_relaxed);
+            alignedFree(buffer);
+            return;
+        }
+    } while (!cachedBytes_.compare_exchange_weak(cached, cached + sizeClass.bytes, std::memory_order_relaxed));
+
+    std::lock_guard<std::mutex> lock(sizeClass.mutex);
+    sizeClass.freeBuffers.push_back(buffer);
+    cachedBuffers_.fetch_add(1, std::memory_order_relaxed);
+}
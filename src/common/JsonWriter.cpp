@@ -0,0 +1,217 @@
+//
+// Created by YJK on 2026/10/16.
+//
+
+#include "common/JsonWriter.h"
+#include "nlohmann/json.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace {
+    // 追加无符号整数的十进制表示
+    void appendUnsigned(std::string& out, uint64_t v) {
+        char buffer[20];
+        char* end = buffer + sizeof(buffer);
+        char* p = end;
+        do {
+            *--p = static_cast<char>('0' + v % 10);
+            v /= 10;
+        } while (v != 0);
+        out.append(p, static_cast<size_t>(end - p));
+    }
+}
+
+void JsonWriter::separate() {
+    if (afterKey_) {
+        afterKey_ = false;
+        return;
+    }
+    if (first_.empty()) {
+        return;
+    }
+    if (first_.back()) {
+        first_.back() = false;
+    } else {
+        out_.push_back(',');
+    }
+}
+
+JsonWriter& JsonWriter::beginObject() {
+    separate();
+    out_.push_back('{');
+    first_.push_back(true);
+    return *this;
+}
+
+JsonWriter& JsonWriter::endObject() {
+    out_.push_back('}');
+    first_.pop_back();
+    return *this;
+}
+
+JsonWriter& JsonWriter::beginArray() {
+    separate();
+    out_.push_back('[');
+    first_.push_back(true);
+    return *this;
+}
+
+JsonWriter& JsonWriter::endArray() {
+    out_.push_back(']');
+    first_.pop_back();
+    return *this;
+}
+
+JsonWriter& JsonWriter::key(std::string_view name) {
+    separate();
+    out_.push_back('"');
+    out_.append(name.data(), name.size());
+    out_.append("\":", 2);
+    afterKey_ = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::writeSigned(int64_t v) {
+    separate();
+    if (v < 0) {
+        out_.push_back('-');
+        appendUnsigned(out_, 0 - static_cast<uint64_t>(v));
+    } else {
+        appendUnsigned(out_, static_cast<uint64_t>(v));
+    }
+    return *this;
+}
+
+JsonWriter& JsonWriter::writeUnsigned(uint64_t v) {
+    separate();
+    appendUnsigned(out_, v);
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(bool v) {
+    separate();
+    if (v) {
+        out_.append("true", 4);
+    } else {
+        out_.append("false", 5);
+    }
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(double v) {
+    separate();
+
+    if (!std::isfinite(v)) {
+        out_.append("null", 4);
+        return *this;
+    }
+
+    // 超出定点表示范围时退回printf
+    if (std::fabs(v) >= 1e14) {
+        char buffer[32];
+        int length = std::snprintf(buffer, sizeof(buffer), "%.4f", v);
+        out_.append(buffer, static_cast<size_t>(length));
+        return *this;
+    }
+
+    long long scaled = std::llround(v * 10000.0);
+    if (scaled < 0) {
+        out_.push_back('-');
+        scaled = -scaled;
+    }
+
+    appendUnsigned(out_, static_cast<uint64_t>(scaled / 10000));
+    out_.push_back('.');
+
+    // 小数部分去掉末尾的0，至少保留一位（整数值输出为 x.0）
+    int fraction = static_cast<int>(scaled % 10000);
+    if (fraction == 0) {
+        out_.push_back('0');
+        return *this;
+    }
+    char digits[4] = {
+            static_cast<char>('0' + fraction / 1000),
+            static_cast<char>('0' + fraction / 100 % 10),
+            static_cast<char>('0' + fraction / 10 % 10),
+            static_cast<char>('0' + fraction % 10)
+    };
+    size_t length = 4;
+    while (digits[length - 1] == '0') {
+        --length;
+    }
+    out_.append(digits, length);
+    return *this;
+}
+
+JsonWriter& JsonWriter::exactValue(double v) {
+    separate();
+
+    if (!std::isfinite(v)) {
+        out_.append("null", 4);
+        return *this;
+    }
+
+    // 使用 nlohmann 序列化浮点数的同一实现（Grisu2），输出与 json::dump 逐字节一致
+    char buffer[64];
+    char* end = nlohmann::detail::to_chars(buffer, buffer + sizeof(buffer), v);
+    out_.append(buffer, static_cast<size_t>(end - buffer));
+
+    // 与 nlohmann 一致，整数值补 ".0" 以保持浮点类型
+    bool integral = std::none_of(buffer, end, [](char c) { return c == '.' || c == 'e'; });
+    if (integral) {
+        out_.append(".0", 2);
+    }
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(std::string_view v) {
+    static const char HEX[] = "0123456789abcdef";
+
+    separate();
+    out_.push_back('"');
+
+    size_t runStart = 0;
+    for (size_t i = 0; i < v.size(); ++i) {
+        auto c = static_cast<unsigned char>(v[i]);
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+
+        out_.append(v.data() + runStart, i - runStart);
+        runStart = i + 1;
+
+        switch (c) {
+            case '"':
+                out_.append("\\\"", 2);
+                break;
+            case '\\':
+                out_.append("\\\\", 2);
+                break;
+            case '\b':
+                out_.append("\\b", 2);
+                break;
+            case '\f':
+                out_.append("\\f", 2);
+                break;
+            case '\n':
+                out_.append("\\n", 2);
+                break;
+            case '\r':
+                out_.append("\\r", 2);
+                break;
+            case '\t':
+                out_.append("\\t", 2);
+                break;
+            default: {
+                char escaped[6] = {'\\', 'u', '0', '0', HEX[c >> 4], HEX[c & 0x0F]};
+                out_.append(escaped, 6);
+                break;
+            }
+        }
+    }
+    out_.append(v.data() + runStart, v.size() - runStart);
+
+    out_.push_back('"');
+    return *this;
+}
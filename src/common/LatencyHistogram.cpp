@@ -0,0 +1,143 @@
+//
+// Created by YJK on 2026/10/16.
+//
+
+#include "common/LatencyHistogram.h"
+#include <algorithm>
+
+size_t LatencyHistogram::bucketIndex(uint64_t micros) {
+    if (micros < SUB_BUCKET_COUNT) {
+        return static_cast<size_t>(micros);
+    }
+
+    const uint64_t maxValue = (1ULL << MAX_VALUE_BITS) - 1;
+    micros = std::min(micros, maxValue);
+
+    // 最高位所在的2的幂区间，保留最高位之后的4位作为子桶序号
+    int msb = 63 - __builtin_clzll(micros);
+    int shift = msb - (SUB_BUCKET_BITS - 1);
+    return static_cast<size_t>(SUB_BUCKET_COUNT + (shift - 1) * SUB_BUCKET_HALF +
+                               ((micros >> shift) - SUB_BUCKET_HALF));
+}
+
+uint64_t LatencyHistogram::bucketLowerBound(size_t index) {
+    if (index < SUB_BUCKET_COUNT) {
+        return index;
+    }
+    size_t offset = index - SUB_BUCKET_COUNT;
+    int shift = static_cast<int>(offset / SUB_BUCKET_HALF) + 1;
+    uint64_t sub = offset % SUB_BUCKET_HALF + SUB_BUCKET_HALF;
+    return sub << shift;
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(size_t index) {
+    if (index < SUB_BUCKET_COUNT) {
+        return index;
+    }
+    size_t offset = index - SUB_BUCKET_COUNT;
+    int shift = static_cast<int>(offset / SUB_BUCKET_HALF) + 1;
+    return bucketLowerBound(index) + (1ULL << shift) - 1;
+}
+
+void LatencyHistogram::record(uint64_t micros) {
+    counts_[bucketIndex(micros)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(micros, std::memory_order_relaxed);
+
+    uint64_t currentMax = max_.load(std::memory_order_relaxed);
+    while (micros > currentMax &&
+           !max_.compare_exchange_weak(currentMax, micros, std::memory_order_relaxed)) {
+    }
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::snapshot() const {
+    Snapshot snap;
+
+    // 先复制各桶计数，总数以桶计数之和为准，保证分位数落在已复制的桶内
+    std::array<uint64_t, BUCKET_COUNT> counts;
+    uint64_t total = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        counts[i] = counts_[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+    if (total == 0) {
+        return snap;
+    }
+
+    snap.count = total;
+    snap.maxUs = max_.load(std::memory_order_relaxed);
+    uint64_t recorded = count_.load(std::memory_order_relaxed);
+    snap.meanUs = recorded > 0 ? static_cast<double>(sum_.load(std::memory_order_relaxed)) / recorded : 0.0;
+
+    // 分位数取所在桶的上界，不超过记录到的最大值
+    const double quantiles[] = {0.5, 0.9, 0.99, 0.999};
+    uint64_t* targets[] = {&snap.p50Us, &snap.p90Us, &snap.p99Us, &snap.p999Us};
+    size_t q = 0;
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i < BUCKET_COUNT && q < 4; ++i) {
+        cumulative += counts[i];
+        while (q < 4 && cumulative > 0 &&
+               static_cast<double>(cumulative) >= quantiles[q] * static_cast<double>(total)) {
+            *targets[q] = std::min(bucketUpperBound(i), snap.maxUs);
+            ++q;
+        }
+    }
+
+    return snap;
+}
+
+uint64_t LatencyHistogram::valueAtQuantile(double quantile) const {
+    std::array<uint64_t, BUCKET_COUNT> counts;
+    uint64_t total = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        counts[i] = counts_[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    uint64_t maxValue = max_.load(std::memory_order_relaxed);
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        cumulative += counts[i];
+        if (cumulative > 0 && static_cast<double>(cumulative) >= quantile * static_cast<double>(total)) {
+            return std::min(bucketUpperBound(i), maxValue);
+        }
+    }
+    return maxValue;
+}
+
+void LatencyHistogram::reset() {
+    for (auto& c : counts_) {
+        c.store(0, std::memory_order_relaxed);
+    }
+    count_.store(0, std::memory_order_relaxed);
+    sum_.store(0, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
+
+const char* latencyStageName(LatencyStage stage) {
+    switch (stage) {
+        case LatencyStage::ADMISSION:
+            return "admission";
+        case LatencyStage::PARSE:
+            return "parse";
+        case LatencyStage::BASE64_DECODE:
+            return "base64_decode";
+        case LatencyStage::IMAGE_DECODE:
+            return "image_decode";
+        case LatencyStage::POOL_WAIT:
+            return "pool_wait";
+        case LatencyStage::INFERENCE:
+            return "inference";
+        case LatencyStage::POSTPROCESS:
+            return "postprocess";
+        case LatencyStage::SERIALIZE:
+            return "serialize";
+        case LatencyStage::TOTAL:
+            return "total";
+        default:
+            return "unknown";
+    }
+}
@@ -4,70 +4,310 @@
 #include <algorithm>
 #include <cstring>
 #include <thread>
+#include <cerrno>
+#include <cstdlib>
+#include <charconv>
 
 #ifdef _WIN32
 #include <direct.h>
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
 #define MKDIR(dir) _mkdir(dir)
 #define PATH_SEPARATOR "\\"
 #else
 #include <sys/stat.h>
+    #include <fcntl.h>
     #include <unistd.h>
     #define MKDIR(dir) mkdir(dir, 0755)
     #define PATH_SEPARATOR "/"
 #endif
 
+// 每个线程独占的环形缓冲：生产者为所属线程，消费者为后台写线程
+struct Logger::LogRing {
+    struct Entry {
+        LogLevel level = LogLevel::INFO;
+        time_t time = 0;
+        std::string text;   // 复用容量，稳定后写入不再分配内存
+    };
+
+    LogRing() : entries(RING_CAPACITY) {}
+
+    std::vector<Entry> entries;
+    alignas(64) std::atomic<size_t> head{0};  // 写线程下一个读取位置
+    alignas(64) std::atomic<size_t> tail{0};  // 生产者下一个写入位置
+    std::atomic<bool> alive{true};            // 所属线程退出时清除
+};
+
 // 静态成员初始化
 std::mutex Logger::logMutex;
-std::ofstream Logger::logFile;
+int Logger::logFd = -1;
 bool Logger::initialized = false;
 bool Logger::useFileOutput = false;
-LogLevel Logger::minimumLevel = LogLevel::INFO;
+std::atomic<LogLevel> Logger::minimumLevel(LogLevel::INFO);
 std::string Logger::logDirectory = "logs";
 std::string Logger::currentLogDate = "";
 std::atomic<bool> Logger::isShuttingDown(false);
 std::atomic<int> Logger::shutdownPhase(0);
+std::mutex Logger::ringsMutex;
+std::vector<std::shared_ptr<Logger::LogRing>> Logger::rings;
+std::atomic<uint64_t> Logger::ringsVersion(0);
+std::mutex Logger::writerMutex;
+std::condition_variable Logger::writerCondition;
+std::condition_variable Logger::flushCondition;
+std::thread Logger::writerThread;
+Logger::WriterState* Logger::writerState = nullptr;
+std::atomic<bool> Logger::writerRunning(false);
+std::atomic<bool> Logger::writerStopRequested(false);
+std::atomic<bool> Logger::writerIdle(false);
+std::atomic<uint64_t> Logger::flushRequests(0);
+std::atomic<uint64_t> Logger::flushCompleted(0);
+std::atomic<uint64_t> Logger::droppedMessages(0);
+
+namespace {
+
+    const char* levelToString(LogLevel level) {
+        switch (level) {
+            case LogLevel::DEBUG:   return "DEBUG";
+            case LogLevel::INFO:    return "INFO";
+            case LogLevel::WARNING: return "WARNING";
+            case LogLevel::ERROR:   return "ERROR";
+            case LogLevel::FATAL:   return "FATAL";
+            default:                return "UNKNOWN";
+        }
+    }
 
-void Logger::init(bool logToFile, const std::string& logDir, LogLevel minLevel) {
-    std::lock_guard<std::mutex> lock(logMutex);
+    // 去除路径，只保留文件名
+    const char* baseName(const char* filepath) {
+        const char* name = filepath;
+        for (const char* p = filepath; *p; ++p) {
+            if (*p == '/' || *p == '\\') {
+                name = p + 1;
+            }
+        }
+        return name;
+    }
 
-    if (initialized) {
-        // 如果已经初始化，先关闭以前的文件
-        if (useFileOutput && logFile.is_open()) {
-            logFile.close();
+    // 位置信息和消息正文：有位置时为 "[file:line][function] msg"，否则为 " msg"
+    void appendBody(std::string& out, std::string_view message,
+                    const char* file, int line, const char* function) {
+        if (file) {
+            char lineStr[16];
+            int lineLen = snprintf(lineStr, sizeof(lineStr), "%d", line);
+            out += '[';
+            out += baseName(file);
+            out += ':';
+            out.append(lineStr, lineLen);
+            out += "][";
+            out += function ? function : "";
+            out += "] ";
+        } else {
+            out += ' ';
         }
+        out += message;
     }
 
-    useFileOutput = logToFile;
-    minimumLevel = minLevel;
-    logDirectory = logDir;
+    // 控制台的文件描述符（Windows CRT 同样为 1、2）
+    constexpr int STDOUT_FD = 1;
+    constexpr int STDERR_FD = 2;
 
-    if (useFileOutput) {
-        // 确保日志目录存在
-        if (!createDirectory(logDirectory)) {
-            std::cerr << "Failed to create log directory: " << logDirectory << std::endl;
-            useFileOutput = false;
-        } else {
-            // 清理旧日志
-            cleanupOldLogs();
-
-            // 初始化日志文件
-            std::string logFilePath = getCurrentLogFilePath();
-            logFile.open(logFilePath, std::ios::out | std::ios::app);
-            if (!logFile.is_open()) {
-                std::cerr << "Failed to open log file: " << logFilePath << std::endl;
-                useFileOutput = false;
+    // 以追加方式打开日志文件，失败时返回 -1
+    int openAppend(const std::string& path) {
+#ifdef _WIN32
+        return _open(path.c_str(), _O_WRONLY | _O_CREAT | _O_APPEND | _O_NOINHERIT, _S_IREAD | _S_IWRITE);
+#else
+        return ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+#endif
+    }
+
+    void closeFd(int fd) {
+#ifdef _WIN32
+        _close(fd);
+#else
+        ::close(fd);
+#endif
+    }
+
+    // 写完整个缓冲区，处理部分写入和信号中断
+    void writeAll(int fd, const char* data, size_t size) {
+        while (size > 0) {
+#ifdef _WIN32
+            int written = _write(fd, data, static_cast<unsigned int>(std::min<size_t>(size, 1u << 30)));
+#else
+            ssize_t written = ::write(fd, data, size);
+#endif
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return;
+            }
+            data += written;
+            size -= static_cast<size_t>(written);
+        }
+    }
+
+    // 线程安全的本地时间转换
+    void localTime(time_t time, struct tm& out) {
+#ifdef _WIN32
+        localtime_s(&out, &time);
+#else
+        localtime_r(&time, &out);
+#endif
+    }
+
+    // 按秒缓存的时间戳前缀，仅由写线程使用
+    struct TimestampCache {
+        time_t second = -1;
+        char prefix[32] = {0};   // "[YYYY-mm-dd HH:MM:SS]"
+        size_t prefixLength = 0;
+        char date[16] = {0};     // "YYYY-mm-dd"
+
+        void update(time_t now) {
+            if (now == second) {
+                return;
+            }
+            second = now;
+            struct tm tmNow;
+            localTime(now, tmNow);
+            prefixLength = strftime(prefix, sizeof(prefix), "[%Y-%m-%d %H:%M:%S]", &tmNow);
+            strftime(date, sizeof(date), "%Y-%m-%d", &tmNow);
+        }
+    };
+
+    // 把一条日志格式化后追加到对应的批量缓冲
+    void appendLine(std::string& out, const TimestampCache& ts, LogLevel level, const std::string& body) {
+        out.append(ts.prefix, ts.prefixLength);
+        out += '[';
+        out += levelToString(level);
+        out += ']';
+        out += body;
+        out += '\n';
+    }
+
+} // namespace
+
+// 写线程在两次取出之间保留的状态，只由写线程（或写线程退出后的 stopWriter）访问
+struct Logger::WriterState {
+    std::vector<std::shared_ptr<LogRing>> localRings;
+    uint64_t localVersion = static_cast<uint64_t>(-1);
+    TimestampCache ts;
+    std::string outBatch;
+    std::string errBatch;
+    std::string fileBatch;
+    uint64_t reportedDrops = 0;
+};
+
+namespace logger_detail {
+
+    template <typename T>
+    void appendInteger(std::string& out, T value) {
+        char buffer[24];
+        auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        out.append(buffer, result.ptr);
+    }
+
+    void appendArg(std::string& out, bool value) { out += value ? "true" : "false"; }
+    void appendArg(std::string& out, char value) { out += value; }
+    void appendArg(std::string& out, int value) { appendInteger(out, value); }
+    void appendArg(std::string& out, long value) { appendInteger(out, value); }
+    void appendArg(std::string& out, long long value) { appendInteger(out, value); }
+    void appendArg(std::string& out, unsigned value) { appendInteger(out, value); }
+    void appendArg(std::string& out, unsigned long value) { appendInteger(out, value); }
+    void appendArg(std::string& out, unsigned long long value) { appendInteger(out, value); }
+    void appendArg(std::string& out, const char* value) { out += value ? value : "(null)"; }
+    void appendArg(std::string& out, std::string_view value) { out += value; }
+    void appendArg(std::string& out, const std::string& value) { out += value; }
+
+    void appendArg(std::string& out, double value) {
+        char buffer[32];
+        int length = snprintf(buffer, sizeof(buffer), "%g", value);
+        if (length > 0) {
+            out.append(buffer, std::min(static_cast<size_t>(length), sizeof(buffer) - 1));
+        }
+    }
+
+    void appendArg(std::string& out, const void* value) {
+        char buffer[32];
+        int length = snprintf(buffer, sizeof(buffer), "%p", value);
+        if (length > 0) {
+            out.append(buffer, std::min(static_cast<size_t>(length), sizeof(buffer) - 1));
+        }
+    }
+
+    void formatArgs(std::string& out, std::string_view fmt, const FormatArg* args, size_t count) {
+        size_t next = 0;
+        size_t i = 0;
+        while (i < fmt.size()) {
+            char c = fmt[i];
+            if (c == '{' && i + 1 < fmt.size()) {
+                if (fmt[i + 1] == '{') {
+                    out += '{';
+                    i += 2;
+                    continue;
+                }
+                if (fmt[i + 1] == '}' && next < count) {
+                    args[next].append(out, args[next].value);
+                    ++next;
+                    i += 2;
+                    continue;
+                }
+            } else if (c == '}' && i + 1 < fmt.size() && fmt[i + 1] == '}') {
+                out += '}';
+                i += 2;
+                continue;
+            }
+            out += c;
+            ++i;
+        }
+    }
+
+} // namespace logger_detail
+
+void Logger::init(bool logToFile, const std::string& logDir, LogLevel minLevel) {
+    {
+        std::lock_guard<std::mutex> lock(logMutex);
+
+        if (initialized) {
+            // 如果已经初始化，先关闭以前的文件
+            if (logFd >= 0) {
+                closeFd(logFd);
+                logFd = -1;
             }
-            else {
-                // 记录当前日期
-                time_t now = time(nullptr);
-                char dateStr[64];
-                strftime(dateStr, sizeof(dateStr), "%Y-%m-%d", localtime(&now));
-                currentLogDate = dateStr;
+        }
+
+        useFileOutput = logToFile;
+        minimumLevel = minLevel;
+        logDirectory = logDir;
+
+        if (useFileOutput) {
+            // 确保日志目录存在
+            if (!createDirectory(logDirectory)) {
+                std::cerr << "Failed to create log directory: " << logDirectory << std::endl;
+                useFileOutput = false;
+            } else {
+                // 清理旧日志
+                cleanupOldLogs();
+
+                // 初始化日志文件
+                if (openLogFile()) {
+                    // 记录当前日期
+                    time_t now = time(nullptr);
+                    char dateStr[64];
+                    struct tm tmNow;
+                    localTime(now, tmNow);
+                    strftime(dateStr, sizeof(dateStr), "%Y-%m-%d", &tmNow);
+                    currentLogDate = dateStr;
+                } else {
+                    useFileOutput = false;
+                }
             }
         }
+
+        initialized = true;
     }
 
-    initialized = true;
+    startWriter();
 }
 
 void Logger::shutdown() {
@@ -191,22 +431,25 @@ void Logger::cleanupOldLogs() {
     }
 }
 
-void Logger::checkAndRotateLogFile() {
-    if (!useFileOutput) return;
+bool Logger::openLogFile() {
+    std::string logFilePath = getCurrentLogFilePath();
+    logFd = openAppend(logFilePath);
+    if (logFd < 0) {
+        std::cerr << "Failed to open log file: " << logFilePath << std::endl;
+        return false;
+    }
+    return true;
+}
 
-    // 获取当前日期
-    time_t now = time(nullptr);
-    char dateStr[64];
-    strftime(dateStr, sizeof(dateStr), "%Y-%m-%d", localtime(&now));
-    std::string todayDate(dateStr);
+void Logger::checkAndRotateLogFile(const std::string& todayDate) {
+    if (!useFileOutput) return;
 
     // 如果日期变了，需要切换日志文件
     if (todayDate != currentLogDate) {
-        std::lock_guard<std::mutex> lock(logMutex);
-
         // 关闭当前日志文件
-        if (logFile.is_open()) {
-            logFile.close();
+        if (logFd >= 0) {
+            closeFd(logFd);
+            logFd = -1;
         }
 
         // 更新当前日期
@@ -216,154 +459,342 @@ void Logger::checkAndRotateLogFile() {
         cleanupOldLogs();
 
         // 打开新的日志文件
-        std::string logFilePath = getCurrentLogFilePath();
-        logFile.open(logFilePath, std::ios::out | std::ios::app);
-        if (!logFile.is_open()) {
-            std::cerr << "Failed to open log file: " << logFilePath << std::endl;
+        if (!openLogFile()) {
             useFileOutput = false;
         }
     }
 }
 
-std::string Logger::extractFilename(const char* filepath) {
-    if (!filepath) return "";
-
-    std::string path(filepath);
-    size_t lastSlash = path.find_last_of("/\\");
-    if (lastSlash != std::string::npos) {
-        return path.substr(lastSlash + 1);
-    }
-    return path;
+void Logger::log(LogLevel level, std::string_view message) {
+    logWithLocation(level, message, nullptr, 0, nullptr);
 }
 
-void Logger::log(LogLevel level, const std::string& message) {
+void Logger::logWithLocation(LogLevel level, std::string_view message,
+                             const char* file, int line, const char* function) {
     // 如果日志系统正在关闭，只允许致命错误和通过shutdownMessage方法发送的消息
     if (isShuttingDown && shutdownPhase >= 2 && level != LogLevel::FATAL) {
         return; // 在最终关闭阶段，丢弃普通消息
     }
 
     // 检查日志级别
-    if (level < minimumLevel) {
+    if (level < minimumLevel.load(std::memory_order_relaxed)) {
         return;
     }
 
-    // 检查是否需要切换日志文件
-    checkAndRotateLogFile();
+    enqueue(level, message, file, line, function, level == LogLevel::FATAL);
+}
 
-    std::lock_guard<std::mutex> lock(logMutex);
+void Logger::logMessage(LogLevel level, std::string_view message,
+                        const char* file, int line, const char* function) {
+    logWithLocation(level, message, file, line, function);
+}
 
-    // 获取当前时间
-    char timeStr[64];
-    time_t now = time(nullptr);
-    strftime(timeStr, sizeof(timeStr), "%Y-%m-%d %H:%M:%S", localtime(&now));
+std::string& Logger::formatBuffer() {
+    static thread_local std::string buffer;
+    return buffer;
+}
 
-    // 转换日志级别为字符串
-    const char* levelStr;
-    switch (level) {
-        case LogLevel::DEBUG:   levelStr = "DEBUG"; break;
-        case LogLevel::INFO:    levelStr = "INFO"; break;
-        case LogLevel::WARNING: levelStr = "WARNING"; break;
-        case LogLevel::ERROR:   levelStr = "ERROR"; break;
-        case LogLevel::FATAL:   levelStr = "FATAL"; break;
-        default:                levelStr = "UNKNOWN";
+Logger::LogRing& Logger::threadRing() {
+    // 线程退出时标记环形缓冲已失效；缓冲仍由注册表持有，写线程取完剩余日志后再回收
+    struct RingHolder {
+        std::shared_ptr<LogRing> ring;
+        ~RingHolder() {
+            if (ring) {
+                ring->alive.store(false, std::memory_order_release);
+            }
+        }
+    };
+    static thread_local RingHolder holder;
+    if (!holder.ring) {
+        holder.ring = std::make_shared<LogRing>();
+        std::lock_guard<std::mutex> lock(ringsMutex);
+        rings.push_back(holder.ring);
+        ringsVersion.fetch_add(1, std::memory_order_release);
+    }
+    return *holder.ring;
+}
+
+void Logger::enqueue(LogLevel level, std::string_view message,
+                     const char* file, int line, const char* function, bool mustDeliver) {
+    if (!writerRunning.load(std::memory_order_acquire)) {
+        writeDirect(level, message, file, line, function);
+        return;
     }
 
-    // 格式化日志消息
-    std::string formattedMessage =
-            std::string("[") + timeStr + "][" + levelStr + "] " + message;
+    LogRing& ring = threadRing();
+    size_t tail = ring.tail.load(std::memory_order_relaxed);
 
-    // 输出到控制台
-    if (level == LogLevel::ERROR || level == LogLevel::FATAL) {
-        std::cerr << formattedMessage << std::endl;
-    } else {
-        std::cout << formattedMessage << std::endl;
+    // 缓冲已满：普通日志直接丢弃并计数，致命错误和关闭消息等待写线程腾出空间
+    while (tail - ring.head.load(std::memory_order_acquire) >= RING_CAPACITY) {
+        if (!mustDeliver) {
+            droppedMessages.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        if (!writerRunning.load(std::memory_order_acquire)) {
+            writeDirect(level, message, file, line, function);
+            return;
+        }
+        wakeWriter();
+        std::this_thread::yield();
+    }
+
+    LogRing::Entry& entry = ring.entries[tail & (RING_CAPACITY - 1)];
+    entry.level = level;
+    entry.time = time(nullptr);
+    entry.text.clear();
+    appendBody(entry.text, message, file, line, function);
+    ring.tail.store(tail + 1, std::memory_order_release);
+
+    // 与写线程进入空闲前的检查配对，避免丢失唤醒
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (writerIdle.load(std::memory_order_relaxed)) {
+        wakeWriter();
+    }
+}
+
+void Logger::wakeWriter() {
+    if (writerIdle.exchange(false)) {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        writerCondition.notify_one();
     }
+}
+
+void Logger::writeDirect(LogLevel level, std::string_view message,
+                         const char* file, int line, const char* function) {
+    TimestampCache ts;
+    ts.update(time(nullptr));
+
+    std::string body;
+    appendBody(body, message, file, line, function);
+    std::string formattedMessage;
+    appendLine(formattedMessage, ts, level, body);
+
+    std::lock_guard<std::mutex> lock(logMutex);
+
+    // 输出到控制台
+    int consoleFd = (level == LogLevel::ERROR || level == LogLevel::FATAL) ? STDERR_FD : STDOUT_FD;
+    writeAll(consoleFd, formattedMessage.data(), formattedMessage.size());
 
     // 输出到文件
-    if (initialized && useFileOutput && logFile.is_open()) {
-        logFile << formattedMessage << std::endl;
-        logFile.flush();
+    if (initialized && useFileOutput && logFd >= 0) {
+        writeAll(logFd, formattedMessage.data(), formattedMessage.size());
     }
 }
 
-void Logger::logWithLocation(LogLevel level, const std::string& message,
-                             const char* file, int line, const char* function) {
-    // 如果日志系统正在关闭，只允许致命错误和通过shutdownMessage方法发送的消息
-    if (isShuttingDown && shutdownPhase >= 2 && level != LogLevel::FATAL) {
-        return; // 在最终关闭阶段，丢弃普通消息
+void Logger::startWriter() {
+    std::lock_guard<std::mutex> lock(writerMutex);
+    if (writerRunning.load()) {
+        return;
     }
+    writerStopRequested = false;
+    writerIdle = false;
+    if (writerState == nullptr) {
+        writerState = new WriterState();
+    }
+    writerThread = std::thread(&Logger::writerLoop);
+    writerRunning.store(true, std::memory_order_release);
+
+    // 未调用 shutdown 就退出进程时，也要写完缓冲并回收写线程
+    static bool exitHookRegistered = false;
+    if (!exitHookRegistered) {
+        exitHookRegistered = true;
+        std::atexit([] { stopWriter(); });
+    }
+}
 
-    // 检查日志级别
-    if (level < minimumLevel) {
+void Logger::stopWriter() {
+    {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        if (!writerRunning.load()) {
+            return;
+        }
+        writerStopRequested = true;
+        writerIdle = false;
+        writerCondition.notify_one();
+    }
+
+    if (writerThread.joinable()) {
+        writerThread.join();
+    }
+
+    // 写线程已退出后，之后的日志走同步写出；再取一次以防生产者在退出前刚写入
+    writerRunning.store(false, std::memory_order_release);
+    drainRings(*writerState);
+
+    // 唤醒仍在等待 flush 的线程
+    {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        flushCompleted.store(flushRequests.load());
+    }
+    flushCondition.notify_all();
+}
+
+void Logger::flush() {
+    if (!writerRunning.load(std::memory_order_acquire)) {
         return;
     }
 
-    // 检查是否需要切换日志文件
-    checkAndRotateLogFile();
+    uint64_t target = flushRequests.fetch_add(1) + 1;
+    {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        writerIdle = false;
+        writerCondition.notify_one();
+    }
 
-    std::lock_guard<std::mutex> lock(logMutex);
+    std::unique_lock<std::mutex> lock(writerMutex);
+    flushCondition.wait(lock, [target] {
+        return flushCompleted.load() >= target || !writerRunning.load();
+    });
+}
 
-    // 获取当前时间
-    char timeStr[64];
-    time_t now = time(nullptr);
-    strftime(timeStr, sizeof(timeStr), "%Y-%m-%d %H:%M:%S", localtime(&now));
+uint64_t Logger::getDroppedCount() {
+    return droppedMessages.load(std::memory_order_relaxed);
+}
 
-    // 转换日志级别为字符串
-    const char* levelStr;
-    switch (level) {
-        case LogLevel::DEBUG:   levelStr = "DEBUG"; break;
-        case LogLevel::INFO:    levelStr = "INFO"; break;
-        case LogLevel::WARNING: levelStr = "WARNING"; break;
-        case LogLevel::ERROR:   levelStr = "ERROR"; break;
-        case LogLevel::FATAL:   levelStr = "FATAL"; break;
-        default:                levelStr = "UNKNOWN";
+bool Logger::drainRings(WriterState& state) {
+    auto& localRings = state.localRings;
+    auto& ts = state.ts;
+    auto& outBatch = state.outBatch;
+    auto& errBatch = state.errBatch;
+    auto& fileBatch = state.fileBatch;
+    auto& reportedDrops = state.reportedDrops;
+
+    uint64_t version = ringsVersion.load(std::memory_order_acquire);
+    if (version != state.localVersion) {
+        std::lock_guard<std::mutex> lock(ringsMutex);
+        localRings = rings;
+        state.localVersion = ringsVersion.load(std::memory_order_relaxed);
     }
 
-    // 提取文件名（去除路径）
-    std::string filename = extractFilename(file);
+    outBatch.clear();
+    errBatch.clear();
+    fileBatch.clear();
 
-    // 格式化带位置信息的日志消息
-    std::string formattedMessage =
-            std::string("[") + timeStr + "][" + levelStr + "][" +
-            filename + ":" + std::to_string(line) + "][" + function + "] " + message;
+    bool fileEnabled;
+    {
+        std::lock_guard<std::mutex> lock(logMutex);
+        fileEnabled = initialized && useFileOutput;
+    }
 
-    // 输出到控制台
-    if (level == LogLevel::ERROR || level == LogLevel::FATAL) {
-        std::cerr << formattedMessage << std::endl;
-    } else {
-        std::cout << formattedMessage << std::endl;
+    bool hasDeadRing = false;
+    for (auto& ring : localRings) {
+        size_t head = ring->head.load(std::memory_order_relaxed);
+        size_t tail = ring->tail.load(std::memory_order_acquire);
+        for (; head != tail; ++head) {
+            const LogRing::Entry& entry = ring->entries[head & (RING_CAPACITY - 1)];
+            ts.update(entry.time);
+            bool toErr = entry.level == LogLevel::ERROR || entry.level == LogLevel::FATAL;
+            appendLine(toErr ? errBatch : outBatch, ts, entry.level, entry.text);
+            if (fileEnabled) {
+                appendLine(fileBatch, ts, entry.level, entry.text);
+            }
+        }
+        ring->head.store(head, std::memory_order_release);
+
+        // 所属线程已退出且已取空（先读 alive，线程退出前写入的日志此时都已可见）
+        if (!ring->alive.load(std::memory_order_acquire) && ring->tail.load(std::memory_order_acquire) == head) {
+            hasDeadRing = true;
+        }
     }
 
-    // 输出到文件
-    if (initialized && useFileOutput && logFile.is_open()) {
-        logFile << formattedMessage << std::endl;
-        logFile.flush();
+    // 报告新增的丢弃条数
+    uint64_t dropped = droppedMessages.load(std::memory_order_relaxed);
+    if (dropped != reportedDrops) {
+        ts.update(time(nullptr));
+        std::string body = " Logger ring buffer full, dropped " + std::to_string(dropped - reportedDrops) +
+                           " messages (total " + std::to_string(dropped) + ")";
+        appendLine(outBatch, ts, LogLevel::WARNING, body);
+        if (fileEnabled) {
+            appendLine(fileBatch, ts, LogLevel::WARNING, body);
+        }
+        reportedDrops = dropped;
+    }
+
+    if (hasDeadRing) {
+        std::lock_guard<std::mutex> lock(ringsMutex);
+        for (auto it = rings.begin(); it != rings.end();) {
+            LogRing& ring = **it;
+            // 只回收所属线程已退出且已取空的缓冲；存活线程的缓冲即使为空也保留
+            if (!ring.alive.load(std::memory_order_acquire) &&
+                ring.head.load(std::memory_order_relaxed) == ring.tail.load(std::memory_order_acquire)) {
+                it = rings.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        ringsVersion.fetch_add(1, std::memory_order_release);
+    }
+
+    if (outBatch.empty() && errBatch.empty()) {
+        return false;
     }
+
+    // 每个目标一次 write()
+    writeAll(STDOUT_FD, outBatch.data(), outBatch.size());
+    writeAll(STDERR_FD, errBatch.data(), errBatch.size());
+
+    std::lock_guard<std::mutex> lock(logMutex);
+    ts.update(time(nullptr));
+    checkAndRotateLogFile(ts.date);
+    if (initialized && useFileOutput && logFd >= 0 && !fileBatch.empty()) {
+        writeAll(logFd, fileBatch.data(), fileBatch.size());
+    }
+    return true;
 }
 
-// 添加一个专门用于关闭过程的消息记录方法
-void Logger::shutdownMessage(const std::string& message) {
-    // 这个方法即使在关闭过程中也会工作
-    char timeStr[64];
-    time_t now = time(nullptr);
-    strftime(timeStr, sizeof(timeStr), "%Y-%m-%d %H:%M:%S", localtime(&now));
+void Logger::writerLoop() {
+    WriterState& state = *writerState;
+    while (true) {
+        uint64_t flushTarget = flushRequests.load();
 
-    std::string formattedMessage = std::string("[") + timeStr + "][INFO] " + message;
+        if (drainRings(state)) {
+            continue;
+        }
 
-    // 总是打印到控制台
-    std::cout << formattedMessage << std::endl;
+        // 已无待写日志，完成之前的 flush 请求
+        if (flushCompleted.load() < flushTarget) {
+            {
+                std::lock_guard<std::mutex> lock(writerMutex);
+                flushCompleted.store(flushTarget);
+            }
+            flushCondition.notify_all();
+        }
 
-    // 只有在初始化阶段和准备关闭阶段尝试写入文件
-    // 在最终关闭阶段，文件操作由finalizeShutdown直接处理
-    if (shutdownPhase < 2) {
-        std::unique_lock<std::mutex> lock(logMutex, std::try_to_lock);
-        if (lock.owns_lock() && initialized && useFileOutput && logFile.is_open()) {
-            logFile << formattedMessage << std::endl;
-            logFile.flush();
+        if (writerStopRequested.load()) {
+            break;
         }
+
+        std::unique_lock<std::mutex> lock(writerMutex);
+        writerIdle.store(true);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        // 进入空闲后再检查一次，生产者可能刚好在设置空闲标志之前写入
+        bool pending = flushRequests.load() != flushTarget || writerStopRequested.load();
+        if (!pending) {
+            std::lock_guard<std::mutex> ringsLock(ringsMutex);
+            for (auto& ring : rings) {
+                if (ring->head.load(std::memory_order_relaxed) != ring->tail.load(std::memory_order_acquire)) {
+                    pending = true;
+                    break;
+                }
+            }
+        }
+
+        if (!pending) {
+            writerCondition.wait_for(lock, std::chrono::milliseconds(WRITER_IDLE_WAIT_MS), [] {
+                return !writerIdle.load();
+            });
+        }
+        writerIdle.store(false);
     }
 }
 
+// 添加一个专门用于关闭过程的消息记录方法
+void Logger::shutdownMessage(const std::string& message) {
+    // 这个方法即使在关闭过程中也会工作，不受日志级别限制
+    enqueue(LogLevel::INFO, message, nullptr, 0, nullptr, true);
+}
+
 // 第一阶段：准备关闭
 void Logger::prepareShutdown() {
     bool expected = false;
@@ -379,48 +810,18 @@ void Logger::prepareShutdown() {
 void Logger::finalizeShutdown() {
     shutdownPhase = 2; // 设置为最终关闭阶段
 
-    // 使用尝试锁定避免死锁
-    std::unique_lock<std::mutex> lock(logMutex, std::try_to_lock);
-
-    if (initialized && useFileOutput && logFile.is_open()) {
-        if (lock.owns_lock()) {
-            // 先记录关闭开始的消息
-            char timeStr[64];
-            time_t now = time(nullptr);
-            strftime(timeStr, sizeof(timeStr), "%Y-%m-%d %H:%M:%S", localtime(&now));
-
-            std::string startMsg = std::string("[") + timeStr + "][INFO] Logger finalizing shutdown";
-            std::cout << startMsg << std::endl;
-            logFile << startMsg << std::endl;
-
-            // 短暂等待，确保所有缓冲区内容都能写入
-            logFile.flush();
+    // 写出缓冲中剩余的日志并停止写线程
+    stopWriter();
 
-            // 再记录完成消息
-            now = time(nullptr);
-            strftime(timeStr, sizeof(timeStr), "%Y-%m-%d %H:%M:%S", localtime(&now));
+    writeDirect(LogLevel::INFO, "Logger finalizing shutdown", nullptr, 0, nullptr);
 
-            std::string completeMsg = std::string("[") + timeStr + "][INFO] Logger finalizing shutdown completed";
-            std::cout << completeMsg << std::endl;
-            logFile << completeMsg << std::endl;
+    writeDirect(LogLevel::INFO, "Logger finalizing shutdown completed", nullptr, 0, nullptr);
 
-            // 最终刷新和关闭
-            logFile.flush();
-            logFile.close();
-        } else {
-            // 如果无法获取锁，只打印到控制台
-            std::cerr << "WARNING: Could not acquire log mutex for clean shutdown" << std::endl;
-            std::cerr << "Logger finalizing shutdown completed (console only)" << std::endl;
-
-            // 等待短暂时间后强制关闭
-            std::this_thread::sleep_for(std::chrono::milliseconds(500));
-            logFile.close(); // 不安全但必要的关闭
-        }
-    } else {
-        // 文件未打开，只记录到控制台
-        std::cout << "Logger finalizing shutdown completed (console only)" << std::endl;
+    std::lock_guard<std::mutex> lock(logMutex);
+    if (logFd >= 0) {
+        closeFd(logFd);
+        logFd = -1;
     }
-
     initialized = false;
 }
 
@@ -39,6 +39,53 @@ ModelConfig ModelConfig::fromJson(const nlohmann::json& j) {
     if (j.contains("objectThresh") && j["objectThresh"].is_number())
         config.objectThresh = j["objectThresh"];
 
+    if (j.contains("backend") && j["backend"].is_string())
+        config.backend = j["backend"];
+
+    if (j.contains("cpu_latency_ms") && j["cpu_latency_ms"].is_number_integer())
+        config.cpuLatencyMs = j["cpu_latency_ms"];
+
+    if (j.contains("cpu_detection_count") && j["cpu_detection_count"].is_number_integer())
+        config.cpuDetectionCount = j["cpu_detection_count"];
+
+    if (j.contains("pool_size") && j["pool_size"].is_number_integer())
+        config.poolSize = j["pool_size"];
+
+    if (j.contains("pool_min_instances") && j["pool_min_instances"].is_number_integer())
+        config.poolMinInstances = j["pool_min_instances"];
+
+    if (j.contains("pool_max_instances") && j["pool_max_instances"].is_number_integer())
+        config.poolMaxInstances = j["pool_max_instances"];
+
+    if (j.contains("batch_size") && j["batch_size"].is_number_integer())
+        config.batchSize = j["batch_size"];
+
+    if (j.contains("max_queue") && j["max_queue"].is_number_integer())
+        config.maxQueue = j["max_queue"];
+
+    if (j.contains("npu_cores") && j["npu_cores"].is_array()) {
+        for (const auto& core : j["npu_cores"]) {
+            if (core.is_number_integer())
+                config.npuCores.push_back(core);
+        }
+    }
+
+    if (j.contains("cpu_affinity") && j["cpu_affinity"].is_array()) {
+        for (const auto& cpu : j["cpu_affinity"]) {
+            if (cpu.is_number_integer())
+                config.cpuAffinity.push_back(cpu);
+        }
+    }
+
+    if (j.contains("input_width") && j["input_width"].is_number_integer())
+        config.inputWidth = j["input_width"];
+
+    if (j.contains("input_height") && j["input_height"].is_number_integer())
+        config.inputHeight = j["input_height"];
+
+    if (j.contains("keypoint_stride") && j["keypoint_stride"].is_number_integer())
+        config.keypointStride = j["keypoint_stride"];
+
     return config;
 }
 
@@ -48,6 +95,19 @@ nlohmann::json ModelConfig::toJson() const {
     j["model_path"] = model_path;
     j["model_type"] = model_type;
     j["objectThresh"] = objectThresh;
+    j["backend"] = backend;
+    j["cpu_latency_ms"] = cpuLatencyMs;
+    j["cpu_detection_count"] = cpuDetectionCount;
+    j["pool_size"] = poolSize;
+    j["pool_min_instances"] = poolMinInstances;
+    j["pool_max_instances"] = poolMaxInstances;
+    j["batch_size"] = batchSize;
+    j["max_queue"] = maxQueue;
+    j["npu_cores"] = npuCores;
+    j["cpu_affinity"] = cpuAffinity;
+    j["input_width"] = inputWidth;
+    j["input_height"] = inputHeight;
+    j["keypoint_stride"] = keypointStride;
     return j;
 }
 
@@ -217,6 +277,24 @@ HTTPServerConfig HTTPServerConfig::fromJson(const nlohmann::json& j) {
     if (j.contains("read_timeout") && j["read_timeout"].is_number_integer())
         config.readTimeout = j["read_timeout"];
 
+    if (j.contains("thread_pool_size") && j["thread_pool_size"].is_number_integer())
+        config.threadPoolSize = j["thread_pool_size"];
+
+    if (j.contains("max_queued_connections") && j["max_queued_connections"].is_number_integer())
+        config.maxQueuedConnections = j["max_queued_connections"];
+
+    if (j.contains("tcp_nodelay") && j["tcp_nodelay"].is_boolean())
+        config.tcpNoDelay = j["tcp_nodelay"];
+
+    if (j.contains("keep_alive_max_count") && j["keep_alive_max_count"].is_number_integer())
+        config.keepAliveMaxCount = j["keep_alive_max_count"];
+
+    if (j.contains("listen_backlog") && j["listen_backlog"].is_number_integer())
+        config.listenBacklog = j["listen_backlog"];
+
+    if (j.contains("payload_max_length") && j["payload_max_length"].is_number_integer())
+        config.payloadMaxLength = j["payload_max_length"];
+
     return config;
 }
 
@@ -226,6 +304,12 @@ nlohmann::json HTTPServerConfig::toJson() const {
     j["port"] = port;
     j["connection_timeout"] = connectionTimeout;
     j["read_timeout"] = readTimeout;
+    j["thread_pool_size"] = threadPoolSize;
+    j["max_queued_connections"] = maxQueuedConnections;
+    j["tcp_nodelay"] = tcpNoDelay;
+    j["keep_alive_max_count"] = keepAliveMaxCount;
+    j["listen_backlog"] = listenBacklog;
+    j["payload_max_length"] = payloadMaxLength;
     return j;
 }
 
@@ -323,6 +407,18 @@ GRPCServerConfig GRPCServerConfig::fromJson(const nlohmann::json& j) {
     if (j.contains("port") && j["port"].is_number_integer())
         config.port = j["port"];
 
+    if (j.contains("compression") && j["compression"].is_string())
+        config.compression = j["compression"];
+
+    if (j.contains("stream_max_inflight") && j["stream_max_inflight"].is_number_integer())
+        config.streamMaxInflight = j["stream_max_inflight"];
+
+    if (j.contains("async_poll_threads") && j["async_poll_threads"].is_number_integer())
+        config.asyncPollThreads = j["async_poll_threads"];
+
+    if (j.contains("async_worker_threads") && j["async_worker_threads"].is_number_integer())
+        config.asyncWorkerThreads = j["async_worker_threads"];
+
     return config;
 }
 
@@ -330,6 +426,10 @@ nlohmann::json GRPCServerConfig::toJson() const {
     nlohmann::json j;
     j["host"] = host;
     j["port"] = port;
+    j["compression"] = compression;
+    j["stream_max_inflight"] = streamMaxInflight;
+    j["async_poll_threads"] = asyncPollThreads;
+    j["async_worker_threads"] = asyncWorkerThreads;
     return j;
 }
 
@@ -344,6 +444,9 @@ ConcurrencyServerConfig ConcurrencyServerConfig::fromJson(const nlohmann::json&
     if (j.contains("max_concurrent_requests") && j["max_concurrent_requests"].is_number_integer())
         config.maxConcurrentRequests = j["max_concurrent_requests"];
 
+    if (j.contains("max_queued_requests") && j["max_queued_requests"].is_number_integer())
+        config.maxQueuedRequests = j["max_queued_requests"];
+
     if (j.contains("model_pool_size") && j["model_pool_size"].is_number_integer())
         config.modelPoolSize = j["model_pool_size"];
 
@@ -356,15 +459,81 @@ ConcurrencyServerConfig ConcurrencyServerConfig::fromJson(const nlohmann::json&
     if (j.contains("enable_concurrency_monitoring") && j["enable_concurrency_monitoring"].is_boolean())
         config.enableConcurrencyMonitoring = j["enable_concurrency_monitoring"];
 
+    if (j.contains("pool_spin_iterations") && j["pool_spin_iterations"].is_number_integer())
+        config.poolSpinIterations = j["pool_spin_iterations"];
+
+    if (j.contains("pool_thread_affinity") && j["pool_thread_affinity"].is_boolean())
+        config.poolThreadAffinity = j["pool_thread_affinity"];
+
+    if (j.contains("batch_max_size") && j["batch_max_size"].is_number_integer())
+        config.batchMaxSize = j["batch_max_size"];
+
+    if (j.contains("batch_max_wait_ms") && j["batch_max_wait_ms"].is_number_integer())
+        config.batchMaxWaitMs = j["batch_max_wait_ms"];
+
+    if (j.contains("pool_autoscale") && j["pool_autoscale"].is_boolean())
+        config.poolAutoscale = j["pool_autoscale"];
+
+    if (j.contains("pool_scale_up_wait_ms") && j["pool_scale_up_wait_ms"].is_number_integer())
+        config.poolScaleUpWaitMs = j["pool_scale_up_wait_ms"];
+
+    if (j.contains("pool_scale_down_idle_ms") && j["pool_scale_down_idle_ms"].is_number_integer())
+        config.poolScaleDownIdleMs = j["pool_scale_down_idle_ms"];
+
+    if (j.contains("pool_scale_interval_ms") && j["pool_scale_interval_ms"].is_number_integer())
+        config.poolScaleIntervalMs = j["pool_scale_interval_ms"];
+
+    if (j.contains("pool_trim_idle_ms") && j["pool_trim_idle_ms"].is_number_integer())
+        config.poolTrimIdleMs = j["pool_trim_idle_ms"];
+
+    if (j.contains("frame_pool_max_cached_mb") && j["frame_pool_max_cached_mb"].is_number_integer())
+        config.framePoolMaxCachedMb = j["frame_pool_max_cached_mb"];
+
+    if (j.contains("frame_pool_preallocate") && j["frame_pool_preallocate"].is_object()) {
+        for (const auto& item : j["frame_pool_preallocate"].items()) {
+            if (item.value().is_number_integer()) {
+                config.framePoolPreallocate[item.key()] = item.value();
+            }
+        }
+    }
+
+    if (j.contains("pipeline_enabled") && j["pipeline_enabled"].is_boolean())
+        config.pipelineEnabled = j["pipeline_enabled"];
+
+    if (j.contains("pipeline_decode_threads") && j["pipeline_decode_threads"].is_number_integer())
+        config.pipelineDecodeThreads = j["pipeline_decode_threads"];
+
+    if (j.contains("pipeline_serialize_threads") && j["pipeline_serialize_threads"].is_number_integer())
+        config.pipelineSerializeThreads = j["pipeline_serialize_threads"];
+
+    if (j.contains("pipeline_queue_depth") && j["pipeline_queue_depth"].is_number_integer())
+        config.pipelineQueueDepth = j["pipeline_queue_depth"];
+
     return config;
 }
 
 nlohmann::json ConcurrencyServerConfig::toJson() const {
     nlohmann::json j;
     j["max_concurrent_requests"] = maxConcurrentRequests;
+    j["max_queued_requests"] = maxQueuedRequests;
     j["model_pool_size"] = modelPoolSize;
     j["request_timeout_ms"] = requestTimeoutMs;
     j["model_acquire_timeout_ms"] = modelAcquireTimeoutMs;
     j["enable_concurrency_monitoring"] = enableConcurrencyMonitoring;
+    j["pool_spin_iterations"] = poolSpinIterations;
+    j["pool_thread_affinity"] = poolThreadAffinity;
+    j["batch_max_size"] = batchMaxSize;
+    j["batch_max_wait_ms"] = batchMaxWaitMs;
+    j["pool_autoscale"] = poolAutoscale;
+    j["pool_scale_up_wait_ms"] = poolScaleUpWaitMs;
+    j["pool_scale_down_idle_ms"] = poolScaleDownIdleMs;
+    j["pool_scale_interval_ms"] = poolScaleIntervalMs;
+    j["pool_trim_idle_ms"] = poolTrimIdleMs;
+    j["frame_pool_max_cached_mb"] = framePoolMaxCachedMb;
+    j["frame_pool_preallocate"] = framePoolPreallocate;
+    j["pipeline_enabled"] = pipelineEnabled;
+    j["pipeline_decode_threads"] = pipelineDecodeThreads;
+    j["pipeline_serialize_threads"] = pipelineSerializeThreads;
+    j["pipeline_queue_depth"] = pipelineQueueDepth;
     return j;
 }
\ No newline at end of file
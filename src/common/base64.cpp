@@ -29,9 +29,15 @@
 
    René Nyffenegger rene.nyffenegger@adp-gmbh.ch
 
+   Local modifications: added base64_decode_into() and base64_thread_buffer()
+   for decoding into caller-provided / reusable buffers; bulk encoding and
+   decoding are delegated to the vectorized code in base64_simd.cpp, the
+   scalar code below handles the remaining bytes.
+
 */
 
 #include "common/base64.h"
+#include "common/base64_simd.h"
 
 #include <algorithm>
 #include <stdexcept>
@@ -126,30 +132,40 @@ std::string base64_encode(unsigned char const* bytes_to_encode, size_t in_len, b
     const char* base64_chars_ = base64_chars[url];
 
     std::string ret;
-    ret.reserve(len_encoded);
+    ret.resize(len_encoded);
+
+    if (in_len == 0) {
+        return ret;
+    }
 
-    unsigned int pos = 0;
+    char* out = &ret[0];
+
+ //
+ // Encode complete blocks with SIMD, the scalar loop handles the rest.
+ //
+    size_t pos = 0;
+    out += base64_simd::encode(bytes_to_encode, in_len, out, url, pos);
 
     while (pos < in_len) {
-        ret.push_back(base64_chars_[(bytes_to_encode[pos + 0] & 0xfc) >> 2]);
+        *out++ = base64_chars_[(bytes_to_encode[pos + 0] & 0xfc) >> 2];
 
         if (pos+1 < in_len) {
-           ret.push_back(base64_chars_[((bytes_to_encode[pos + 0] & 0x03) << 4) + ((bytes_to_encode[pos + 1] & 0xf0) >> 4)]);
+           *out++ = base64_chars_[((bytes_to_encode[pos + 0] & 0x03) << 4) + ((bytes_to_encode[pos + 1] & 0xf0) >> 4)];
 
            if (pos+2 < in_len) {
-              ret.push_back(base64_chars_[((bytes_to_encode[pos + 1] & 0x0f) << 2) + ((bytes_to_encode[pos + 2] & 0xc0) >> 6)]);
-              ret.push_back(base64_chars_[  bytes_to_encode[pos + 2] & 0x3f]);
+              *out++ = base64_chars_[((bytes_to_encode[pos + 1] & 0x0f) << 2) + ((bytes_to_encode[pos + 2] & 0xc0) >> 6)];
+              *out++ = base64_chars_[  bytes_to_encode[pos + 2] & 0x3f];
            }
            else {
-              ret.push_back(base64_chars_[(bytes_to_encode[pos + 1] & 0x0f) << 2]);
-              ret.push_back(trailing_char);
+              *out++ = base64_chars_[(bytes_to_encode[pos + 1] & 0x0f) << 2];
+              *out++ = trailing_char;
            }
         }
         else {
 
-            ret.push_back(base64_chars_[(bytes_to_encode[pos + 0] & 0x03) << 4]);
-            ret.push_back(trailing_char);
-            ret.push_back(trailing_char);
+            *out++ = base64_chars_[(bytes_to_encode[pos + 0] & 0x03) << 4];
+            *out++ = trailing_char;
+            *out++ = trailing_char;
         }
 
         pos += 3;
@@ -159,38 +175,33 @@ std::string base64_encode(unsigned char const* bytes_to_encode, size_t in_len, b
     return ret;
 }
 
-template <typename String>
-static std::string decode(String encoded_string, bool remove_linebreaks) {
+static size_t decoded_max_size(size_t encoded_length) {
+    return (encoded_length + 3) / 4 * 3;
+}
+
+static size_t decode_chunks(const char* encoded_string, size_t length_of_string, unsigned char* out) {
  //
- // decode(…) is templated so that it can be used with String = const std::string&
- // or std::string_view (requires at least C++17)
+ // Decodes into a buffer of at least decoded_max_size(length_of_string) bytes
+ // and returns the number of bytes written.
  //
+ // Runs of complete chunks in the standard alphabet are decoded with SIMD.
+ // Whenever the SIMD code stops (padding, url characters, invalid input or
+ // the tail of the string), one chunk is decoded by the scalar code below,
+ // which also reports invalid input.
+ //
+    size_t pos = 0;
+    unsigned char* dst = out;
 
-    if (encoded_string.empty()) return std::string();
-
-    if (remove_linebreaks) {
-
-       std::string copy(encoded_string);
-
-       copy.erase(std::remove(copy.begin(), copy.end(), '\n'), copy.end());
-
-       return base64_decode(copy, false);
-    }
+    while (pos < length_of_string) {
 
-    size_t length_of_string = encoded_string.length();
-    size_t pos = 0;
+       size_t consumed = 0;
+       dst += base64_simd::decode(encoded_string + pos, length_of_string - pos, dst, consumed);
+       pos += consumed;
 
- //
- // The approximate length (bytes) of the decoded string might be one or
- // two bytes smaller, depending on the amount of trailing equal signs
- // in the encoded string. This approximation is needed to reserve
- // enough space in the string to be returned.
- //
-    size_t approx_length_of_decoded_string = length_of_string / 4 * 3;
-    std::string ret;
-    ret.reserve(approx_length_of_decoded_string);
+       if (pos >= length_of_string) {
+          break;
+       }
 
-    while (pos < length_of_string) {
     //
     // Iterate over encoded input string in chunks. The size of all
     // chunks except the last one is 4 bytes.
@@ -204,39 +215,71 @@ static std::string decode(String encoded_string, bool remove_linebreaks) {
     // The last chunk produces at least one and up to three bytes.
     //
 
-       size_t pos_of_char_1 = pos_of_char(encoded_string[pos+1] );
+       if (pos + 1 >= length_of_string) {
+          throw std::runtime_error("Input is not valid base64-encoded data.");
+       }
+
+       unsigned int pos_of_char_1 = pos_of_char(encoded_string[pos+1]);
 
     //
     // Emit the first output byte that is produced in each chunk:
     //
-       ret.push_back(static_cast<std::string::value_type>( ( (pos_of_char(encoded_string[pos+0]) ) << 2 ) + ( (pos_of_char_1 & 0x30 ) >> 4)));
+       *dst++ = static_cast<unsigned char>((pos_of_char(encoded_string[pos+0]) << 2) + ((pos_of_char_1 & 0x30) >> 4));
 
-       if ( ( pos + 2 < length_of_string  )       &&  // Check for data that is not padded with equal signs (which is allowed by RFC 2045)
-              encoded_string[pos+2] != '='        &&
-              encoded_string[pos+2] != '.'            // accept URL-safe base 64 strings, too, so check for '.' also.
+       if ( ( pos + 2 < length_of_string ) &&  // Check for data that is not padded with equal signs (which is allowed by RFC 2045)
+              encoded_string[pos+2] != '=' &&
+              encoded_string[pos+2] != '.'     // accept URL-safe base 64 strings, too, so check for '.' also.
           )
        {
        //
        // Emit a chunk's second byte (which might not be produced in the last chunk).
        //
-          unsigned int pos_of_char_2 = pos_of_char(encoded_string[pos+2] );
-          ret.push_back(static_cast<std::string::value_type>( (( pos_of_char_1 & 0x0f) << 4) + (( pos_of_char_2 & 0x3c) >> 2)));
+          unsigned int pos_of_char_2 = pos_of_char(encoded_string[pos+2]);
+          *dst++ = static_cast<unsigned char>(((pos_of_char_1 & 0x0f) << 4) + ((pos_of_char_2 & 0x3c) >> 2));
 
-          if ( ( pos + 3 < length_of_string )     &&
-                 encoded_string[pos+3] != '='     &&
+          if ( ( pos + 3 < length_of_string ) &&
+                 encoded_string[pos+3] != '=' &&
                  encoded_string[pos+3] != '.'
              )
           {
           //
           // Emit a chunk's third byte (which might not be produced in the last chunk).
           //
-             ret.push_back(static_cast<std::string::value_type>( ( (pos_of_char_2 & 0x03 ) << 6 ) + pos_of_char(encoded_string[pos+3])   ));
+             *dst++ = static_cast<unsigned char>(((pos_of_char_2 & 0x03) << 6) + pos_of_char(encoded_string[pos+3]));
           }
        }
 
        pos += 4;
     }
 
+    return static_cast<size_t>(dst - out);
+}
+
+template <typename String>
+static std::string decode(String encoded_string, bool remove_linebreaks) {
+ //
+ // decode(…) is templated so that it can be used with String = const std::string&
+ // or std::string_view (requires at least C++17)
+ //
+
+    if (encoded_string.empty()) return std::string();
+
+    if (remove_linebreaks) {
+
+       std::string copy(encoded_string);
+
+       copy.erase(std::remove(copy.begin(), copy.end(), '\n'), copy.end());
+
+       return base64_decode(copy, false);
+    }
+
+    std::string ret;
+    ret.resize(decoded_max_size(encoded_string.length()));
+
+    size_t written = decode_chunks(encoded_string.data(), encoded_string.length(),
+                                   reinterpret_cast<unsigned char*>(&ret[0]));
+    ret.resize(written);
+
     return ret;
 }
 
@@ -279,4 +322,32 @@ std::string base64_decode(std::string_view s, bool remove_linebreaks) {
    return decode(s, remove_linebreaks);
 }
 
+size_t base64_decoded_max_size(size_t encoded_length) {
+   return decoded_max_size(encoded_length);
+}
+
+size_t base64_decode_into(std::string_view encoded_string, unsigned char* out, size_t capacity) {
+    if (capacity < decoded_max_size(encoded_string.length())) {
+       throw std::runtime_error("Output buffer too small for base64-decoded data.");
+    }
+
+    return decode_chunks(encoded_string.data(), encoded_string.length(), out);
+}
+
+size_t base64_decode_into(std::string_view s, std::vector<unsigned char>& out) {
+ //
+ // resize() only reallocates when the capacity is insufficient, so a reused
+ // vector settles at the size of the largest image seen.
+ //
+    out.resize(base64_decoded_max_size(s.size()));
+    size_t written = base64_decode_into(s, out.data(), out.size());
+    out.resize(written);
+    return written;
+}
+
+std::vector<unsigned char>& base64_thread_buffer() {
+    thread_local std::vector<unsigned char> buffer;
+    return buffer;
+}
+
 #endif  // __cplusplus >= 201703L
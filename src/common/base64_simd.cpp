@@ -0,0 +1,384 @@
+//
+// Created by YJK on 2026/10/16.
+//
+
+#include "common/base64_simd.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define BASE64_SIMD_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define BASE64_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace base64_simd {
+
+namespace {
+
+    using DecodeFn = size_t (*)(const char*, size_t, unsigned char*, size_t&);
+    using EncodeFn = size_t (*)(const unsigned char*, size_t, char*, bool, size_t&);
+
+    struct Codec {
+        const char* name;
+        DecodeFn decode;
+        EncodeFn encode;
+    };
+
+    size_t decodeNone(const char*, size_t, unsigned char*, size_t& consumed) {
+        consumed = 0;
+        return 0;
+    }
+
+    size_t encodeNone(const unsigned char*, size_t, char*, bool, size_t& consumed) {
+        consumed = 0;
+        return 0;
+    }
+
+#if defined(BASE64_SIMD_X86)
+
+    //
+    // 解码：16个字符 -> 12个字节（Wojciech Muła 的 pshufb 查表校验 + 乘加合并）
+    //
+
+    // 校验并把ASCII转换为6位值，含非法字符时返回false
+    __attribute__((target("sse4.1")))
+    inline bool translateSse(__m128i& str) {
+        const __m128i lutLo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                            0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+        const __m128i lutHi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                            0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+        const __m128i lutRoll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71,
+                                              0, 0, 0, 0, 0, 0, 0, 0);
+        const __m128i nibbleMask = _mm_set1_epi8(0x0f);
+
+        const __m128i hiNibbles = _mm_and_si128(_mm_srli_epi32(str, 4), nibbleMask);
+        const __m128i loNibbles = _mm_and_si128(str, nibbleMask);
+        const __m128i hi = _mm_shuffle_epi8(lutHi, hiNibbles);
+        const __m128i lo = _mm_shuffle_epi8(lutLo, loNibbles);
+        if (!_mm_testz_si128(lo, hi)) {
+            return false;
+        }
+
+        const __m128i eqSlash = _mm_cmpeq_epi8(str, _mm_set1_epi8('/'));
+        const __m128i roll = _mm_shuffle_epi8(lutRoll, _mm_add_epi8(eqSlash, hiNibbles));
+        str = _mm_add_epi8(str, roll);
+        return true;
+    }
+
+    // 把每4个6位值合并为3个字节，结果位于低12字节
+    __attribute__((target("sse4.1")))
+    inline __m128i packSse(__m128i values) {
+        const __m128i mergeAbBc = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+        const __m128i merged = _mm_madd_epi16(mergeAbBc, _mm_set1_epi32(0x00011000));
+        return _mm_shuffle_epi8(merged, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+    }
+
+    __attribute__((target("sse4.1")))
+    size_t decodeSse(const char* in, size_t length, unsigned char* out, size_t& consumed) {
+        size_t pos = 0;
+        unsigned char* dst = out;
+
+        // 每次写入16字节（有效12字节），保留足够余量避免越过输出缓冲区
+        while (length - pos >= 24) {
+            __m128i str = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + pos));
+            if (!translateSse(str)) {
+                break;
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), packSse(str));
+            pos += 16;
+            dst += 12;
+        }
+
+        consumed = pos;
+        return static_cast<size_t>(dst - out);
+    }
+
+    __attribute__((target("avx2")))
+    size_t decodeAvx2(const char* in, size_t length, unsigned char* out, size_t& consumed) {
+        const __m256i lutLo = _mm256_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                               0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+                                               0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                               0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+        const __m256i lutHi = _mm256_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                               0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+                                               0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                               0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+        const __m256i lutRoll = _mm256_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71,
+                                                 0, 0, 0, 0, 0, 0, 0, 0,
+                                                 0, 16, 19, 4, -65, -65, -71, -71,
+                                                 0, 0, 0, 0, 0, 0, 0, 0);
+        const __m256i nibbleMask = _mm256_set1_epi8(0x0f);
+        const __m256i slash = _mm256_set1_epi8('/');
+        const __m256i packShuffle = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                                                     2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+        const __m256i laneCompact = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7);
+
+        size_t pos = 0;
+        unsigned char* dst = out;
+
+        // 每次写入32字节（有效24字节）
+        while (length - pos >= 48) {
+            __m256i str = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + pos));
+
+            const __m256i hiNibbles = _mm256_and_si256(_mm256_srli_epi32(str, 4), nibbleMask);
+            const __m256i loNibbles = _mm256_and_si256(str, nibbleMask);
+            const __m256i hi = _mm256_shuffle_epi8(lutHi, hiNibbles);
+            const __m256i lo = _mm256_shuffle_epi8(lutLo, loNibbles);
+            if (!_mm256_testz_si256(lo, hi)) {
+                break;
+            }
+
+            const __m256i eqSlash = _mm256_cmpeq_epi8(str, slash);
+            const __m256i roll = _mm256_shuffle_epi8(lutRoll, _mm256_add_epi8(eqSlash, hiNibbles));
+            str = _mm256_add_epi8(str, roll);
+
+            const __m256i mergeAbBc = _mm256_maddubs_epi16(str, _mm256_set1_epi32(0x01400140));
+            __m256i merged = _mm256_madd_epi16(mergeAbBc, _mm256_set1_epi32(0x00011000));
+            merged = _mm256_shuffle_epi8(merged, packShuffle);
+            merged = _mm256_permutevar8x32_epi32(merged, laneCompact);
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), merged);
+            pos += 32;
+            dst += 24;
+        }
+
+        // 剩余部分用128位处理
+        size_t tailConsumed = 0;
+        size_t tailWritten = decodeSse(in + pos, length - pos, dst, tailConsumed);
+
+        consumed = pos + tailConsumed;
+        return static_cast<size_t>(dst - out) + tailWritten;
+    }
+
+    //
+    // 编码：12个字节 -> 16个字符（Wojciech Muła 的乘法拆分 + 查表平移）
+    //
+
+    __attribute__((target("sse4.1")))
+    inline __m128i splitSse(__m128i in) {
+        in = _mm_shuffle_epi8(in, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+        const __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+        const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+        const __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+        const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+        return _mm_or_si128(t1, t3);
+    }
+
+    __attribute__((target("sse4.1")))
+    inline __m128i toAsciiSse(__m128i indices, __m128i shiftLut) {
+        __m128i result = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+        const __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+        result = _mm_or_si128(result, _mm_and_si128(less, _mm_set1_epi8(13)));
+        result = _mm_shuffle_epi8(shiftLut, result);
+        return _mm_add_epi8(result, indices);
+    }
+
+    __attribute__((target("sse4.1")))
+    inline __m128i shiftLutSse(bool url) {
+        return _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                             '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                             url ? '-' - 62 : '+' - 62, url ? '_' - 63 : '/' - 63, 'A', 0, 0);
+    }
+
+    __attribute__((target("sse4.1")))
+    size_t encodeSse(const unsigned char* in, size_t length, char* out, bool url, size_t& consumed) {
+        const __m128i shiftLut = shiftLutSse(url);
+
+        size_t pos = 0;
+        char* dst = out;
+
+        // 每次读取16字节（使用12字节）
+        while (length - pos >= 16) {
+            __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + pos));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), toAsciiSse(splitSse(bytes), shiftLut));
+            pos += 12;
+            dst += 16;
+        }
+
+        consumed = pos;
+        return static_cast<size_t>(dst - out);
+    }
+
+    __attribute__((target("avx2")))
+    size_t encodeAvx2(const unsigned char* in, size_t length, char* out, bool url, size_t& consumed) {
+        const __m256i splitShuffle = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+                                                      1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+        const __m256i shiftLut = _mm256_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                                  '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                                  url ? '-' - 62 : '+' - 62, url ? '_' - 63 : '/' - 63, 'A', 0, 0,
+                                                  'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                                  '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                                  url ? '-' - 62 : '+' - 62, url ? '_' - 63 : '/' - 63, 'A', 0, 0);
+
+        size_t pos = 0;
+        char* dst = out;
+
+        // 两个128位通道各处理12字节，第二次读取越过12字节后的4字节
+        while (length - pos >= 28) {
+            __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + pos));
+            __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + pos + 12));
+            __m256i bytes = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+
+            bytes = _mm256_shuffle_epi8(bytes, splitShuffle);
+            const __m256i t0 = _mm256_and_si256(bytes, _mm256_set1_epi32(0x0fc0fc00));
+            const __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+            const __m256i t2 = _mm256_and_si256(bytes, _mm256_set1_epi32(0x003f03f0));
+            const __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+            const __m256i indices = _mm256_or_si256(t1, t3);
+
+            __m256i result = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+            const __m256i less = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+            result = _mm256_or_si256(result, _mm256_and_si256(less, _mm256_set1_epi8(13)));
+            result = _mm256_shuffle_epi8(shiftLut, result);
+            result = _mm256_add_epi8(result, indices);
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), result);
+            pos += 24;
+            dst += 32;
+        }
+
+        size_t tailConsumed = 0;
+        size_t tailWritten = encodeSse(in + pos, length - pos, dst, url, tailConsumed);
+
+        consumed = pos + tailConsumed;
+        return static_cast<size_t>(dst - out) + tailWritten;
+    }
+
+    Codec detectCodec() {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return {"avx2", decodeAvx2, encodeAvx2};
+        }
+        if (__builtin_cpu_supports("sse4.1")) {
+            return {"sse4.1", decodeSse, encodeSse};
+        }
+        return {"scalar", decodeNone, encodeNone};
+    }
+
+#elif defined(BASE64_SIMD_NEON)
+
+    //
+    // 解码：64个字符 -> 48个字节，vld4/vst3 完成交织
+    //
+
+    // ASCII转换为6位值，非法字符得到0xff
+    inline uint8x16_t translateNeon(uint8x16_t c) {
+        const uint8x16_t upper = vsubq_u8(c, vdupq_n_u8('A'));
+        const uint8x16_t lower = vsubq_u8(c, vdupq_n_u8('a'));
+        const uint8x16_t digit = vsubq_u8(c, vdupq_n_u8('0'));
+
+        uint8x16_t result = vdupq_n_u8(0xff);
+        result = vbslq_u8(vcltq_u8(upper, vdupq_n_u8(26)), upper, result);
+        result = vbslq_u8(vcltq_u8(lower, vdupq_n_u8(26)), vaddq_u8(lower, vdupq_n_u8(26)), result);
+        result = vbslq_u8(vcltq_u8(digit, vdupq_n_u8(10)), vaddq_u8(digit, vdupq_n_u8(52)), result);
+        result = vbslq_u8(vceqq_u8(c, vdupq_n_u8('+')), vdupq_n_u8(62), result);
+        result = vbslq_u8(vceqq_u8(c, vdupq_n_u8('/')), vdupq_n_u8(63), result);
+        return result;
+    }
+
+    size_t decodeNeon(const char* in, size_t length, unsigned char* out, size_t& consumed) {
+        size_t pos = 0;
+        unsigned char* dst = out;
+
+        while (length - pos >= 64) {
+            uint8x16x4_t str = vld4q_u8(reinterpret_cast<const uint8_t*>(in + pos));
+            const uint8x16_t a = translateNeon(str.val[0]);
+            const uint8x16_t b = translateNeon(str.val[1]);
+            const uint8x16_t c = translateNeon(str.val[2]);
+            const uint8x16_t d = translateNeon(str.val[3]);
+
+            if (vmaxvq_u8(vorrq_u8(vorrq_u8(a, b), vorrq_u8(c, d))) > 63) {
+                break;
+            }
+
+            uint8x16x3_t bytes;
+            bytes.val[0] = vorrq_u8(vshlq_n_u8(a, 2), vshrq_n_u8(b, 4));
+            bytes.val[1] = vorrq_u8(vshlq_n_u8(b, 4), vshrq_n_u8(c, 2));
+            bytes.val[2] = vorrq_u8(vshlq_n_u8(c, 6), d);
+            vst3q_u8(dst, bytes);
+
+            pos += 64;
+            dst += 48;
+        }
+
+        consumed = pos;
+        return static_cast<size_t>(dst - out);
+    }
+
+    //
+    // 编码：48个字节 -> 64个字符，vld3/vst4 完成交织，vqtbl4 查表
+    //
+
+    const char kStandardChars[64 + 1] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    const char kUrlChars[64 + 1] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+    size_t encodeNeon(const unsigned char* in, size_t length, char* out, bool url, size_t& consumed) {
+        const uint8_t* chars = reinterpret_cast<const uint8_t*>(url ? kUrlChars : kStandardChars);
+        uint8x16x4_t table;
+        table.val[0] = vld1q_u8(chars);
+        table.val[1] = vld1q_u8(chars + 16);
+        table.val[2] = vld1q_u8(chars + 32);
+        table.val[3] = vld1q_u8(chars + 48);
+        const uint8x16_t mask = vdupq_n_u8(0x3f);
+
+        size_t pos = 0;
+        char* dst = out;
+
+        while (length - pos >= 48) {
+            uint8x16x3_t bytes = vld3q_u8(in + pos);
+
+            uint8x16x4_t indices;
+            indices.val[0] = vshrq_n_u8(bytes.val[0], 2);
+            indices.val[1] = vandq_u8(vorrq_u8(vshlq_n_u8(bytes.val[0], 4), vshrq_n_u8(bytes.val[1], 4)), mask);
+            indices.val[2] = vandq_u8(vorrq_u8(vshlq_n_u8(bytes.val[1], 2), vshrq_n_u8(bytes.val[2], 6)), mask);
+            indices.val[3] = vandq_u8(bytes.val[2], mask);
+
+            uint8x16x4_t result;
+            result.val[0] = vqtbl4q_u8(table, indices.val[0]);
+            result.val[1] = vqtbl4q_u8(table, indices.val[1]);
+            result.val[2] = vqtbl4q_u8(table, indices.val[2]);
+            result.val[3] = vqtbl4q_u8(table, indices.val[3]);
+            vst4q_u8(reinterpret_cast<uint8_t*>(dst), result);
+
+            pos += 48;
+            dst += 64;
+        }
+
+        consumed = pos;
+        return static_cast<size_t>(dst - out);
+    }
+
+    Codec detectCodec() {
+        // aarch64 上 NEON 为必备特性
+        return {"neon", decodeNeon, encodeNeon};
+    }
+
+#else
+
+    Codec detectCodec() {
+        return {"scalar", decodeNone, encodeNone};
+    }
+
+#endif
+
+    const Codec& activeCodec() {
+        static const Codec codec = detectCodec();
+        return codec;
+    }
+
+} // namespace
+
+const char* implementationName() {
+    return activeCodec().name;
+}
+
+size_t decode(const char* in, size_t length, unsigned char* out, size_t& consumed) {
+    return activeCodec().decode(in, length, out, consumed);
+}
+
+size_t encode(const unsigned char* in, size_t length, char* out, bool url, size_t& consumed) {
+    return activeCodec().encode(in, length, out, url, consumed);
+}
+
+} // namespace base64_simd
@@ -9,6 +9,8 @@
 #define PATH_SEPARATOR "\\"
 #else
 #include <sys/stat.h>
+    #include <pthread.h>
+    #include <sched.h>
     #include <unistd.h>
     #include <errno.h>
     #define PATH_SEPARATOR "/"
@@ -169,3 +171,23 @@ json any_to_json(const std::any& value) {
         return nullptr;
     }
 }
+
+bool setThreadAffinity(std::thread& thread, const std::vector<int>& cpus) {
+#if defined(__linux__)
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    for (int cpu : cpus) {
+        if (cpu >= 0 && cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &cpuSet);
+        }
+    }
+    if (CPU_COUNT(&cpuSet) == 0) {
+        return false;
+    }
+    return pthread_setaffinity_np(thread.native_handle(), sizeof(cpuSet), &cpuSet) == 0;
+#else
+    (void)thread;
+    (void)cpus;
+    return false;
+#endif
+}
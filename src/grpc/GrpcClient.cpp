@@ -28,18 +28,25 @@ bool GrpcClient::processImage(const std::string& base64_image,
                               int model_type,
                               std::vector<std::vector<float>>& detection_results,
                               std::vector<std::string>& plate_results,
-                              std::string& error_message) {
+                              std::string& error_message,
+                              int priority,
+                              int deadline_ms) {
 
     // 准备请求
     grpc_service::ImageRequest request;
     request.set_image_base64(base64_image);
     request.set_model_type(model_type);
+    request.set_priority(priority);
+    request.set_deadline_ms(deadline_ms);
 
     // 准备响应
     grpc_service::ImageResponse response;
 
     // 客户端上下文
     grpc::ClientContext context;
+    if (deadline_ms > 0) {
+        context.set_deadline(std::chrono::system_clock::now() + std::chrono::milliseconds(deadline_ms));
+    }
 
     // 调用RPC
     LOGGER_INFO("Sending gRPC ProcessImage request, model_type=" + std::to_string(model_type));
@@ -77,6 +84,61 @@ bool GrpcClient::processImage(const std::string& base64_image,
     return true;
 }
 
+std::unique_ptr<GrpcClient::ImageStream> GrpcClient::openImageStream() {
+    std::unique_ptr<ImageStream> session(new ImageStream());
+    session->stream_ = stub_->ProcessImageStream(&session->context_);
+    if (!session->stream_) {
+        LOGGER_ERROR("Failed to open gRPC ProcessImageStream");
+        return nullptr;
+    }
+
+    LOGGER_INFO("gRPC ProcessImageStream opened");
+    return session;
+}
+
+bool GrpcClient::ImageStream::send(uint64_t frame_id,
+                                   const std::string& image,
+                                   int model_type,
+                                   int priority,
+                                   int deadline_ms) {
+    grpc_service::ImageFrame frame;
+    frame.set_frame_id(frame_id);
+    frame.set_image(image);
+    frame.set_model_type(model_type);
+    frame.set_priority(priority);
+    frame.set_deadline_ms(deadline_ms);
+
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    if (writes_done_) {
+        return false;
+    }
+    return stream_->Write(frame);
+}
+
+bool GrpcClient::ImageStream::read(grpc_service::FrameResult& result) {
+    return stream_->Read(&result);
+}
+
+bool GrpcClient::ImageStream::finish(std::string& error_message) {
+    {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        if (!writes_done_) {
+            stream_->WritesDone();
+            writes_done_ = true;
+        }
+    }
+
+    grpc::Status status = stream_->Finish();
+    if (!status.ok()) {
+        error_message = status.error_message();
+        LOGGER_ERROR("gRPC ProcessImageStream failed: " + error_message);
+        return false;
+    }
+
+    LOGGER_INFO("gRPC ProcessImageStream successfully completed");
+    return true;
+}
+
 bool GrpcClient::controlModel(const std::string& model_name,
                               int model_type,
                               bool enable,
@@ -1,9 +1,11 @@
 // src/grpc/GrpcServer.cpp
 #include "grpc/GrpcServer.h"
 #include "common/Logger.h"
+#include <algorithm>
 
-GrpcServer::GrpcServer(const std::string& server_address)
-        : server_address_(server_address), running_(false) {
+GrpcServer::GrpcServer(const std::string& server_address, grpc_compression_algorithm compression,
+                       int async_poll_threads)
+        : server_address_(server_address), running_(false), async_poll_threads_(std::max(1, async_poll_threads)) {
     // 在构造函数中设置服务器选项
     builder_.AddListeningPort(server_address_, grpc::InsecureServerCredentials());
 
@@ -11,8 +13,10 @@ GrpcServer::GrpcServer(const std::string& server_address)
     builder_.SetMaxReceiveMessageSize(8 * 1024 * 1024); // 8MB最大接收消息大小
     builder_.SetMaxSendMessageSize(8 * 1024 * 1024);    // 8MB最大发送消息大小
 
-    // 设置压缩选项
-    builder_.SetDefaultCompressionAlgorithm(GRPC_COMPRESS_GZIP);
+    // 设置压缩选项：图像数据本身已压缩，默认不再对响应做gzip
+    if (compression != GRPC_COMPRESS_NONE) {
+        builder_.SetDefaultCompressionAlgorithm(compression);
+    }
 }
 
 GrpcServer::~GrpcServer() {
@@ -36,14 +40,36 @@ bool GrpcServer::start() {
     }
 
     try {
+        // 异步服务需要的完成队列必须在构建前创建
+        if (!async_services_.empty()) {
+            for (int i = 0; i < async_poll_threads_; ++i) {
+                completion_queues_.push_back(builder_.AddCompletionQueue());
+            }
+        }
+
         // 构建并启动服务器
         server_ = builder_.BuildAndStart();
 
         if (!server_) {
             LOGGER_ERROR("Failed to start gRPC server at " + server_address_);
+            completion_queues_.clear();
             return false;
         }
 
+        if (!completion_queues_.empty()) {
+            std::vector<grpc::ServerCompletionQueue*> queues;
+            for (auto& queue : completion_queues_) {
+                queues.push_back(queue.get());
+            }
+            for (auto& service : async_services_) {
+                service->startAsync(queues);
+            }
+            for (auto* queue : queues) {
+                poll_threads_.emplace_back(&GrpcServer::pollCompletionQueue, queue);
+            }
+            LOGGER_INFO("gRPC async services started with " + std::to_string(queues.size()) + " polling threads");
+        }
+
         running_ = true;
         LOGGER_INFO("gRPC server successfully started at " + server_address_);
         return true;
@@ -70,9 +96,25 @@ void GrpcServer::stop() {
                     std::chrono::seconds(SHUTDOWN_TIMEOUT_SECONDS);
 
     server_->Shutdown(deadline);
+
+    // 等待异步调用全部提交完成，再关闭完成队列并排空剩余事件
+    for (auto& service : async_services_) {
+        service->stopAsync();
+    }
+    for (auto& queue : completion_queues_) {
+        queue->Shutdown();
+    }
+    for (auto& thread : poll_threads_) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+    poll_threads_.clear();
+    completion_queues_.clear();
     running_ = false;
 
     // 服务器停止时清理服务
+    async_services_.clear();
     services_.clear();
 
     LOGGER_INFO("gRPC server stopped");
@@ -82,3 +124,24 @@ bool GrpcServer::isRunning() const {
     std::lock_guard<std::mutex> lock(server_mutex_);
     return running_;
 }
+
+void GrpcServer::pollCompletionQueue(grpc::ServerCompletionQueue* queue) {
+    void* tag = nullptr;
+    bool ok = false;
+    while (queue->Next(&tag, &ok)) {
+        static_cast<GrpcAsyncCall*>(tag)->proceed(ok);
+    }
+}
+
+grpc_compression_algorithm GrpcServer::compressionFromString(const std::string& name) {
+    if (name == "gzip") {
+        return GRPC_COMPRESS_GZIP;
+    }
+    if (name == "deflate") {
+        return GRPC_COMPRESS_DEFLATE;
+    }
+    if (!name.empty() && name != "none") {
+        LOGGER_WARNING("Unknown gRPC compression algorithm '" + name + "', compression disabled");
+    }
+    return GRPC_COMPRESS_NONE;
+}
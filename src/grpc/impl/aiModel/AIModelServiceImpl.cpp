@@ -6,159 +6,476 @@
 #include "app/ApplicationManager.h"
 #include "common/Logger.h"
 #include "common/base64.h"
+#include "common/FramePool.h"
 #include "opencv2/opencv.hpp"
 #include <thread>
 #include <chrono>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+
+/**
+ * @brief 一次异步 ProcessImage 调用的状态机
+ * 接收到调用后立即挂起下一个待接收调用，并把推理交给工作线程池；Finish 完成后自行释放
+ */
+class AIModelServiceImpl::ProcessImageCall final : public GrpcAsyncCall {
+public:
+    ProcessImageCall(AIModelServiceImpl* service, grpc::ServerCompletionQueue* queue)
+            : service_(service), queue_(queue), responder_(&context_) {
+        service_->RequestProcessImage(&context_, &request_, &responder_, queue_, queue_, this);
+    }
+
+    void proceed(bool ok) override {
+        if (state_ == State::FINISHING || !ok) {
+            // 调用结束，或服务器关闭时未接收到调用
+            delete this;
+            return;
+        }
+
+        state_ = State::PROCESSING;
+
+        // 保持一个待接收的调用
+        if (!service_->shuttingDown_.load()) {
+            new ProcessImageCall(service_, queue_);
+        }
+
+        // 工作线程池的排队上限即 max_queued_requests：超出时不再缓存请求（及其图像数据），立即拒绝
+        auto result = service_->workerPool_->trySubmit([this]() {
+            grpc::Status status = service_->handleProcessImage(&context_, &request_, &response_);
+            finish(status);
+        });
+        if (result == ThreadPool::SubmitResult::QUEUE_FULL) {
+            service_->appManager_.getAdmissionController().recordRejected();
+            finish(grpc::Status(grpc::StatusCode::RESOURCE_EXHAUSTED,
+                                AdmissionController::statusToString(AdmissionController::Status::QUEUE_FULL)));
+        } else if (result == ThreadPool::SubmitResult::STOPPED) {
+            finish(grpc::Status(grpc::StatusCode::UNAVAILABLE, "Server is shutting down"));
+        }
+    }
+
+private:
+    enum class State { WAITING, PROCESSING, FINISHING };
+
+    void finish(const grpc::Status& status) {
+        state_ = State::FINISHING;
+        responder_.Finish(response_, status, this);
+    }
+
+    AIModelServiceImpl* service_;
+    grpc::ServerCompletionQueue* queue_;
+    grpc::ServerContext context_;
+    grpc_service::ImageRequest request_;
+    grpc_service::ImageResponse response_;
+    grpc::ServerAsyncResponseWriter<grpc_service::ImageResponse> responder_;
+    State state_ = State::WAITING;
+};
 
 AIModelServiceImpl::AIModelServiceImpl(ApplicationManager& appManager)
         : appManager_(appManager) {}
 
-grpc::Status AIModelServiceImpl::ProcessImage(
+void AIModelServiceImpl::startAsync(const std::vector<grpc::ServerCompletionQueue*>& queues) {
+    const auto& concurrency = appManager_.getConcurrencyConfig();
+    int workerThreads = appManager_.getGRPCServerConfig().asyncWorkerThreads;
+    if (workerThreads <= 0) {
+        workerThreads = concurrency.maxConcurrentRequests > 0
+                        ? concurrency.maxConcurrentRequests
+                        : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+
+    // 等待工作线程的调用数以 max_queued_requests 为上限；并发与排队都不限制时才不设上限
+    size_t maxQueued = ThreadPool::UNBOUNDED;
+    if (concurrency.maxConcurrentRequests > 0 || concurrency.maxQueuedRequests > 0) {
+        maxQueued = static_cast<size_t>(std::max(0, concurrency.maxQueuedRequests));
+    }
+
+    shuttingDown_ = false;
+    workerPool_ = std::make_unique<ThreadPool>(static_cast<size_t>(workerThreads), maxQueued);
+
+    for (auto* queue : queues) {
+        new ProcessImageCall(this, queue);
+    }
+
+    LOGGER_INFO("Async ProcessImage started on " + std::to_string(queues.size()) +
+                 " completion queues with " + std::to_string(workerThreads) + " worker threads, max queued calls: " +
+                 (maxQueued == ThreadPool::UNBOUNDED ? std::string("unlimited") : std::to_string(maxQueued)));
+}
+
+void AIModelServiceImpl::stopAsync() {
+    shuttingDown_ = true;
+
+    // 执行完已排队的调用，保证每个调用都已提交 Finish
+    if (workerPool_) {
+        workerPool_->shutdown();
+    }
+
+    LOGGER_INFO("Async ProcessImage stopped");
+}
+
+int AIModelServiceImpl::remainingBudgetMs(const grpc::ServerContext* context, int requestDeadlineMs) {
+    int budgetMs = 0;
+    auto clientDeadline = context->deadline();
+    if (clientDeadline != std::chrono::system_clock::time_point::max()) {
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                clientDeadline - std::chrono::system_clock::now()).count();
+        budgetMs = static_cast<int>(std::max<long long>(1, std::min<long long>(remaining, INT32_MAX)));
+    }
+    if (requestDeadlineMs > 0 && (budgetMs == 0 || requestDeadlineMs < budgetMs)) {
+        budgetMs = requestDeadlineMs;
+    }
+    return budgetMs;
+}
+
+grpc::Status AIModelServiceImpl::handleProcessImage(
         grpc::ServerContext* context,
         const grpc_service::ImageRequest* request,
         grpc_service::ImageResponse* response) {
 
+    LOGGER_INFO_F("Received gRPC ProcessImage request, thread: {}",
+                  std::hash<std::thread::id>{}(std::this_thread::get_id()));
+
+    // 截止时间取客户端deadline、deadline_ms与request_timeout_ms中最早者
+    int budgetMs = remainingBudgetMs(context, request->deadline_ms());
+
+    // 原始字节优先，兼容旧客户端的base64文本
+    if (!request->image().empty()) {
+        return processEncodedImage(request->image(), false, request->model_type(), request->priority(),
+                                   budgetMs, response);
+    }
+    return processEncodedImage(request->image_base64(), true, request->model_type(), request->priority(),
+                               budgetMs, response);
+}
+
+grpc::Status AIModelServiceImpl::ProcessImageStream(
+        grpc::ServerContext* context,
+        grpc::ServerReaderWriter<grpc_service::FrameResult, grpc_service::ImageFrame>* stream) {
+
+    auto streamId = std::hash<std::thread::id>{}(std::this_thread::get_id());
+    size_t maxInflight = static_cast<size_t>(std::max(1, appManager_.getGRPCServerConfig().streamMaxInflight));
+    LOGGER_INFO("gRPC ProcessImageStream opened, max inflight: " + std::to_string(maxInflight) +
+                 ", thread: " + std::to_string(streamId));
+
+    // 当前线程读取帧并提交到共享的推理工作线程池，线程数不随流的数量增长；
+    // 处理中的帧达到上限时停止读取，由gRPC流控向客户端施加背压
+    std::mutex inflightMutex;
+    std::condition_variable inflightCondition;
+    size_t inflight = 0;
+
+    std::mutex writeMutex;
+    std::atomic<bool> writeFailed{false};
+    std::atomic<bool> poolClosed{false};
+    std::atomic<size_t> processedFrames{0};
+
+    auto processFrame = [&](const grpc_service::ImageFrame& frame) {
+        if (writeFailed.load() || context->IsCancelled()) {
+            return;
+        }
+
+        // 每帧的截止时间不晚于整条流的deadline
+        grpc_service::FrameResult result;
+        result.set_frame_id(frame.frame_id());
+        grpc::Status status = processEncodedImage(frame.image(), false, frame.model_type(), frame.priority(),
+                                                  remainingBudgetMs(context, frame.deadline_ms()),
+                                                  result.mutable_response());
+        result.set_status_code(static_cast<int>(status.error_code()));
+        if (!status.ok()) {
+            result.mutable_response()->set_success(false);
+            result.mutable_response()->set_message(status.error_message());
+        }
+        processedFrames++;
+
+        std::lock_guard<std::mutex> lock(writeMutex);
+        if (!writeFailed.load() && !stream->Write(result)) {
+            writeFailed = true;
+        }
+    };
+
+    grpc_service::ImageFrame frame;
+    while (!writeFailed.load() && stream->Read(&frame)) {
+        {
+            std::unique_lock<std::mutex> lock(inflightMutex);
+            inflightCondition.wait(lock, [&] { return inflight < maxInflight; });
+            ++inflight;
+        }
+
+        auto task = std::make_shared<grpc_service::ImageFrame>(std::move(frame));
+        bool submitted = workerPool_->submit([&, task]() {
+            processFrame(*task);
+            // 通知须在锁内完成：最后一帧完成后本函数随即返回，局部变量被销毁
+            std::lock_guard<std::mutex> lock(inflightMutex);
+            --inflight;
+            inflightCondition.notify_all();
+        });
+        if (!submitted) {
+            std::lock_guard<std::mutex> lock(inflightMutex);
+            --inflight;
+            poolClosed = true;
+            break;
+        }
+    }
+
+    // 等待已提交的帧全部处理并写回
+    {
+        std::unique_lock<std::mutex> lock(inflightMutex);
+        inflightCondition.wait(lock, [&] { return inflight == 0; });
+    }
+
+    LOGGER_INFO("gRPC ProcessImageStream closed, frames: " + std::to_string(processedFrames.load()) +
+                 ", thread: " + std::to_string(streamId));
+
+    if (context->IsCancelled()) {
+        return grpc::Status(grpc::StatusCode::CANCELLED, "Stream cancelled by client");
+    }
+    if (poolClosed.load()) {
+        return grpc::Status(grpc::StatusCode::UNAVAILABLE, "Server is shutting down");
+    }
+    if (writeFailed.load()) {
+        return grpc::Status(grpc::StatusCode::UNAVAILABLE, "Failed to write frame result");
+    }
+    return grpc::Status::OK;
+}
+
+void AIModelServiceImpl::fillImageResponse(const InferenceOutput& output,
+                                           long long processingMs,
+                                           grpc_service::ImageResponse* response) {
+    response->set_success(true);
+    response->set_message("Processing successful (time: " + std::to_string(processingMs) + "ms)");
+
+    // 添加检测结果：[x1, y1, x2, y2, score, class_id, 附加数值...]
+    for (size_t i = 0; i < output.size(); ++i) {
+        auto* values = response->add_detection_results()->mutable_values();
+        values->Reserve(static_cast<int>(6 + output.keypointOffsets[i + 1] - output.keypointOffsets[i]));
+        for (size_t k = 0; k < 4; ++k) {
+            values->AddAlreadyReserved(output.boxes[i * 4 + k]);
+        }
+        values->AddAlreadyReserved(output.scores[i]);
+        values->AddAlreadyReserved(static_cast<float>(output.classIds[i]));
+        for (uint32_t k = output.keypointOffsets[i]; k < output.keypointOffsets[i + 1]; ++k) {
+            values->AddAlreadyReserved(output.keypoints[k]);
+        }
+    }
+
+    // 添加车牌结果
+    for (const auto& plate : output.plateResults) {
+        response->add_plate_results(plate);
+    }
+}
+
+std::string AIModelServiceImpl::inferenceFailureDetail(int modelType, int timeoutMs) const {
+    // 获取模型池状态用于错误诊断
+    auto poolStatus = appManager_.getModelPoolStatus(modelType);
+    std::string errorDetail = "Model inference failed for type " + std::to_string(modelType);
+
+    if (poolStatus.totalModels == 0) {
+        errorDetail += " - No model instances available";
+    } else if (!poolStatus.isEnabled) {
+        errorDetail += " - Model pool is disabled";
+    } else if (poolStatus.availableModels == 0) {
+        errorDetail += " - All model instances are busy (timeout after " +
+                       std::to_string(timeoutMs) + "ms)";
+    }
+    return errorDetail;
+}
+
+grpc::Status AIModelServiceImpl::processEncodedImage(
+        const std::string& payload,
+        bool isBase64,
+        int modelType,
+        int priority,
+        int budgetMs,
+        grpc_service::ImageResponse* response) {
+
     // 获取请求ID用于日志跟踪
     auto requestId = std::this_thread::get_id();
     auto start_time = std::chrono::high_resolution_clock::now();
+    auto requestStart = std::chrono::steady_clock::now();
+    auto stageStart = requestStart;
+    StageTimings timings;
 
     // 开始gRPC请求监控
     appManager_.startGrpcRequest();
 
     try {
-        LOGGER_INFO("Received gRPC ProcessImage request, thread: " +
-                     std::to_string(std::hash<std::thread::id>{}(requestId)));
-
         // 验证请求参数
-        std::string base64_image = request->image_base64();
-        int model_type = request->model_type();
-
-        if (base64_image.empty()) {
+        if (payload.empty()) {
             appManager_.failGrpcRequest();
             response->set_success(false);
             response->set_message("Empty image data");
             return grpc::Status::OK;
         }
 
-        if (model_type <= 0) {
+        if (modelType <= 0) {
             appManager_.failGrpcRequest();
             response->set_success(false);
             response->set_message("Invalid model type");
             return grpc::Status::OK;
         }
 
-        // 解码base64图像
-        std::vector<unsigned char> decoded_data;
-        try {
-            std::string decoded_str = base64_decode(base64_image);
-//            decoded_data = std::vector<unsigned char>(decoded_str.begin(), decoded_str.end());
-            decoded_data.reserve(decoded_str.size());
-            decoded_data.assign(
-                    std::make_move_iterator(decoded_str.begin()),
-                    std::make_move_iterator(decoded_str.end())
-            );
-        } catch (const std::exception& e) {
+        // 准入控制
+        auto permit = appManager_.admitRequest(budgetMs);
+        if (!permit.admitted()) {
             appManager_.failGrpcRequest();
-            response->set_success(false);
-            response->set_message("Base64 decode failed: " + std::string(e.what()));
-            return grpc::Status::OK;
+            auto code = permit.status() == AdmissionController::Status::QUEUE_FULL
+                        ? grpc::StatusCode::RESOURCE_EXHAUSTED
+                        : (permit.status() == AdmissionController::Status::DEADLINE_EXCEEDED
+                           ? grpc::StatusCode::DEADLINE_EXCEEDED
+                           : grpc::StatusCode::UNAVAILABLE);
+            return grpc::Status(code, AdmissionController::statusToString(permit.status()));
         }
+        stageStart = timings.mark(LatencyStage::ADMISSION, stageStart);
 
-        cv::Mat ori_img = cv::imdecode(decoded_data, cv::IMREAD_COLOR);
-        if (ori_img.empty()) {
+        // 调度属性：优先级越大越先获得模型实例
+        AcquirePriority acquirePriority;
+        acquirePriority.priority = priority;
+        acquirePriority.deadline = permit.deadline();
+
+        // 排队期间已过期的请求不再解码
+        if (permit.expired()) {
+            appManager_.getAdmissionController().recordExpired();
             appManager_.failGrpcRequest();
-            response->set_success(false);
-            response->set_message("Image decoding failed");
-            return grpc::Status::OK;
+            return grpc::Status(grpc::StatusCode::DEADLINE_EXCEEDED, "Request deadline exceeded before processing");
         }
 
-        LOGGER_INFO("Processing gRPC image request - model_type: " + std::to_string(model_type) +
-                     ", image_size: " + std::to_string(ori_img.cols) + "x" + std::to_string(ori_img.rows) +
-                     ", thread: " + std::to_string(std::hash<std::thread::id>{}(requestId)));
-
-        // 获取超时配置
-        int timeout = appManager_.getConcurrencyConfig().modelAcquireTimeoutMs;
-
-        // 使用模型池进行推理
-        std::vector<std::vector<std::any>> results_vector;
-        std::vector<std::string> plate_results_vector;
+        // base64文本解码到当前线程的复用缓冲区；原始字节直接使用
+        const unsigned char* data = reinterpret_cast<const unsigned char*>(payload.data());
+        size_t size = payload.size();
+        if (isBase64) {
+            std::vector<unsigned char>& decoded_data = base64_thread_buffer();
+            try {
+                base64_decode_into(payload, decoded_data);
+            } catch (const std::exception& e) {
+                appManager_.failGrpcRequest();
+                response->set_success(false);
+                response->set_message("Base64 decode failed: " + std::string(e.what()));
+                return grpc::Status::OK;
+            }
+            data = decoded_data.data();
+            size = decoded_data.size();
+            stageStart = timings.mark(LatencyStage::BASE64_DECODE, stageStart);
+        }
 
-        bool success = appManager_.executeModelInference(model_type,
-                                                         ori_img,
-                                                         results_vector,
-                                                         plate_results_vector,
-                                                         timeout);
+        // 结果写入当前线程复用的缓冲区；解码图像在响应填充完成后随 frame 析构归还
+        static thread_local InferenceOutput output;
+        FramePool::Frame frame;
+        long long processingMs = 0;
+        std::chrono::steady_clock::time_point serializeEnd;
+
+        if (auto* pipeline = appManager_.getPipeline()) {
+            // 分阶段流水线：解码、推理、填充响应分别在各自的线程池中执行，当前线程只等待结果
+            InferencePipeline::Job job;
+            job.data = data;
+            job.size = size;
+            job.modelType = modelType;
+            job.inputSize = appManager_.getModelInputSize(modelType);
+            job.timeoutMs = permit.boundTimeout(appManager_.getConcurrencyConfig().modelAcquireTimeoutMs);
+            job.priority = acquirePriority;
+            job.timings = &timings;
+            job.frame = &frame;
+            job.output = &output;
+            job.serialize = [&]() {
+                auto end_time = std::chrono::high_resolution_clock::now();
+                processingMs = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+                auto fillStart = std::chrono::steady_clock::now();
+                fillImageResponse(output, processingMs, response);
+                serializeEnd = timings.mark(LatencyStage::SERIALIZE, fillStart);
+            };
+
+            auto result = pipeline->execute(job);
+            if (result == InferencePipeline::Result::EXPIRED) {
+                appManager_.getAdmissionController().recordExpired();
+                appManager_.failGrpcRequest();
+                return grpc::Status(grpc::StatusCode::DEADLINE_EXCEEDED, "Request deadline exceeded before inference");
+            }
+            if (result == InferencePipeline::Result::INFERENCE_FAILED) {
+                appManager_.failGrpcRequest();
+                response->set_success(false);
+                response->set_message(inferenceFailureDetail(modelType, job.timeoutMs));
+                return grpc::Status::OK;
+            }
+            if (result != InferencePipeline::Result::OK) {
+                appManager_.failGrpcRequest();
+                response->set_success(false);
+                response->set_message(result == InferencePipeline::Result::DECODE_FAILED
+                                      ? "Image decoding failed" : InferencePipeline::resultToString(result));
+                return grpc::Status::OK;
+            }
 
-        if (!success) {
-            appManager_.failGrpcRequest();
+            LOGGER_INFO_F("Processed gRPC image request through pipeline - model_type: {}, image_size: {}x{}, decoded: {}x{}, thread: {}",
+                          modelType, frame.originalSize().width, frame.originalSize().height,
+                          frame.image().cols, frame.image().rows, std::hash<std::thread::id>{}(requestId));
+        } else {
+            // 解码写入缓冲池中的缓冲区；远大于模型输入的JPEG降采样解码
+            stageStart = std::chrono::steady_clock::now();
+            if (!FramePool::getInstance().decode(data, size, cv::IMREAD_COLOR, frame,
+                                                 appManager_.getModelInputSize(modelType))) {
+                appManager_.failGrpcRequest();
+                response->set_success(false);
+                response->set_message("Image decoding failed");
+                return grpc::Status::OK;
+            }
+            timings.mark(LatencyStage::IMAGE_DECODE, stageStart);
+            const cv::Mat& ori_img = frame.image();
+
+            LOGGER_INFO_F("Processing gRPC image request - model_type: {}, image_size: {}x{}, decoded: {}x{}, thread: {}",
+                          modelType, frame.originalSize().width, frame.originalSize().height,
+                          ori_img.cols, ori_img.rows, std::hash<std::thread::id>{}(requestId));
+
+            // 获取超时配置
+            int timeout = permit.boundTimeout(appManager_.getConcurrencyConfig().modelAcquireTimeoutMs);
+            if (timeout <= 0) {
+                appManager_.getAdmissionController().recordExpired();
+                appManager_.failGrpcRequest();
+                return grpc::Status(grpc::StatusCode::DEADLINE_EXCEEDED, "Request deadline exceeded before inference");
+            }
 
-            // 获取模型池状态用于错误诊断
-            auto poolStatus = appManager_.getModelPoolStatus(model_type);
-            std::string errorDetail = "Model inference failed for type " + std::to_string(model_type);
-
-            if (poolStatus.totalModels == 0) {
-                errorDetail += " - No model instances available";
-            } else if (!poolStatus.isEnabled) {
-                errorDetail += " - Model pool is disabled";
-            } else if (poolStatus.availableModels == 0) {
-                errorDetail += " - All model instances are busy (timeout after " +
-                               std::to_string(timeout) + "ms)";
+            // 使用模型池进行推理
+            bool success = appManager_.executeModelInference(modelType,
+                                                             ori_img,
+                                                             output,
+                                                             0.0,
+                                                             0.0,
+                                                             timeout,
+                                                             acquirePriority,
+                                                             &timings);
+
+            if (!success) {
+                appManager_.failGrpcRequest();
+                response->set_success(false);
+                response->set_message(inferenceFailureDetail(modelType, timeout));
+                return grpc::Status::OK;
             }
 
-            response->set_success(false);
-            response->set_message(errorDetail);
-            return grpc::Status::OK;
-        }
+            // 降采样解码时检测框换算回原图坐标
+            if (frame.reduced()) {
+                output.scaleBoxes(frame.scaleX(), frame.scaleY());
+            }
 
-        // 计算处理时间
-        auto end_time = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+            // 计算处理时间
+            auto end_time = std::chrono::high_resolution_clock::now();
+            processingMs = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+            stageStart = std::chrono::steady_clock::now();
 
-        // 填充响应
-        response->set_success(true);
-        response->set_message("Processing successful (time: " + std::to_string(duration.count()) + "ms)");
-
-        // 添加检测结果 - 线程安全的结果转换
-        for (const auto& inner_vec : results_vector) {
-            auto* detection = response->add_detection_results();
-            for (const auto& value : inner_vec) {
-                try {
-                    if (value.type() == typeid(float)) {
-                        detection->add_values(std::any_cast<float>(value));
-                    } else if (value.type() == typeid(double)) {
-                        detection->add_values(static_cast<float>(std::any_cast<double>(value)));
-                    } else if (value.type() == typeid(int)) {
-                        detection->add_values(static_cast<float>(std::any_cast<int>(value)));
-                    }
-                } catch (const std::bad_any_cast& e) {
-                    LOGGER_WARNING("Failed to cast result value: " + std::string(e.what()) +
-                                    ", thread: " + std::to_string(std::hash<std::thread::id>{}(requestId)));
-                }
-            }
+            // 序列化阶段只含响应消息的填充，线上编码由gRPC在处理函数返回后完成
+            fillImageResponse(output, processingMs, response);
+            serializeEnd = timings.mark(LatencyStage::SERIALIZE, stageStart);
         }
 
-        // 添加车牌结果
-        for (const auto& plate : plate_results_vector) {
-            response->add_plate_results(plate);
-        }
+        timings.set(LatencyStage::TOTAL, requestStart, serializeEnd);
+        appManager_.recordGrpcLatency(modelType, timings);
 
-        LOGGER_INFO("gRPC ProcessImage completed successfully - model_type: " +
-                     std::to_string(model_type) + ", time: " + std::to_string(duration.count()) + "ms" +
-                     ", thread: " + std::to_string(std::hash<std::thread::id>{}(requestId)));
+        LOGGER_INFO_F("gRPC image processing completed successfully - model_type: {}, time: {}ms, thread: {}",
+                      modelType, processingMs, std::hash<std::thread::id>{}(requestId));
 
         // 完成gRPC请求监控
         appManager_.completeGrpcRequest();
 
-        results_vector.clear();
-        plate_results_vector.clear();
-        std::vector<std::vector<std::any>>().swap(results_vector);
-        std::vector<std::string>().swap(plate_results_vector);
-
         return grpc::Status::OK;
 
     } catch (const std::exception& e) {
         appManager_.failGrpcRequest();
-        LOGGER_ERROR("gRPC ProcessImage error: " + std::string(e.what()) +
+        LOGGER_ERROR("gRPC image processing error: " + std::string(e.what()) +
                       ", thread: " + std::to_string(std::hash<std::thread::id>{}(requestId)));
         response->set_success(false);
         response->set_message("Internal error: " + std::string(e.what()));
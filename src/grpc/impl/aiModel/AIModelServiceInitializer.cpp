@@ -27,8 +27,8 @@ bool AIModelServiceInitializer::initialize(GrpcServer* server) {
         // 创建服务实现实例
         serviceImpl_ = std::make_shared<AIModelServiceImpl>(appManager_);
 
-        // 注册服务到gRPC服务器
-        bool result = server->registerService(serviceImpl_);
+        // 注册服务到gRPC服务器（ProcessImage 为异步方法，由服务器的完成队列驱动）
+        bool result = server->registerAsyncService(serviceImpl_);
 
         if (!result) {
             LOGGER_ERROR("Unable to register AI model service to gRPC server");
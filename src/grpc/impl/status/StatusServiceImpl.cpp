@@ -150,9 +150,11 @@ grpc::Status StatusServiceImpl::GetConcurrencyStats(
 
         // 填充HTTP统计
         fillConcurrencyStats(httpStats, response->mutable_http_stats());
+        fillLatencyStats(appManager_.getHttpLatencyStats(), response->mutable_http_stats());
 
         // 填充gRPC统计
         fillConcurrencyStats(grpcStats, response->mutable_grpc_stats());
+        fillLatencyStats(appManager_.getGrpcLatencyStats(), response->mutable_grpc_stats());
 
         // 填充综合统计
         response->set_total_active(httpStats.active + grpcStats.active);
@@ -192,6 +194,25 @@ void StatusServiceImpl::fillConcurrencyStats(const ConcurrencyMonitor::Stats& st
     grpcStats->set_success_rate(1.0 - stats.failureRate);
 }
 
+void StatusServiceImpl::fillLatencyStats(const std::vector<ConcurrencyMonitor::LatencyStats>& latencies,
+                                         grpc_service::ConcurrencyStats* grpcStats) {
+    if (!grpcStats) return;
+
+    grpcStats->mutable_latencies()->Reserve(static_cast<int>(latencies.size()));
+    for (const auto& latency : latencies) {
+        auto* item = grpcStats->add_latencies();
+        item->set_stage(latencyStageName(latency.stage));
+        item->set_model_type(latency.modelType);
+        item->set_count(static_cast<int64_t>(latency.snapshot.count));
+        item->set_mean_us(latency.snapshot.meanUs);
+        item->set_p50_us(static_cast<int64_t>(latency.snapshot.p50Us));
+        item->set_p90_us(static_cast<int64_t>(latency.snapshot.p90Us));
+        item->set_p99_us(static_cast<int64_t>(latency.snapshot.p99Us));
+        item->set_p999_us(static_cast<int64_t>(latency.snapshot.p999Us));
+        item->set_max_us(static_cast<int64_t>(latency.snapshot.maxUs));
+    }
+}
+
 void StatusServiceImpl::fillModelPoolInfo(int modelType,
                                           const ModelPool::PoolStatus& poolStatus,
                                           grpc_service::ModelPoolInfo* poolInfo) {
@@ -205,15 +226,20 @@ void StatusServiceImpl::fillModelPoolInfo(int modelType,
     poolInfo->set_model_path(poolStatus.modelPath);
     poolInfo->set_threshold(poolStatus.threshold);
 
-    // 计算利用率和可用率
-    double utilizationRate = 0.0;
+    // 利用率为时间加权值，可用率为当前空闲比例
     double availabilityRate = 0.0;
 
     if (poolStatus.totalModels > 0) {
-        utilizationRate = static_cast<double>(poolStatus.busyModels) / poolStatus.totalModels;
         availabilityRate = static_cast<double>(poolStatus.availableModels) / poolStatus.totalModels;
     }
 
-    poolInfo->set_utilization_rate(utilizationRate);
+    poolInfo->set_utilization_rate(poolStatus.utilization);
     poolInfo->set_availability_rate(availabilityRate);
+    poolInfo->set_busy_time_seconds(poolStatus.busyTimeSeconds);
+    poolInfo->set_uptime_seconds(poolStatus.uptimeSeconds);
+    poolInfo->set_acquire_wait_count(static_cast<int64_t>(poolStatus.acquireWait.count));
+    poolInfo->set_acquire_wait_total_seconds(poolStatus.totalWaitSeconds);
+    poolInfo->set_acquire_wait_p50_us(static_cast<int64_t>(poolStatus.acquireWait.p50Us));
+    poolInfo->set_acquire_wait_p99_us(static_cast<int64_t>(poolStatus.acquireWait.p99Us));
+    poolInfo->set_acquire_timeouts(static_cast<int64_t>(poolStatus.timeoutCount));
 }
\ No newline at end of file
@@ -0,0 +1,297 @@
+//
+// Created by YJK on 2026/10/16.
+//
+
+#include "handlers/InferenceRequestParser.h"
+#include "nlohmann/json.hpp"
+#include <iterator>
+
+using json = nlohmann::json;
+
+namespace {
+
+    /**
+     * @brief 跳过 img 字符串的状态，由迭代器与SAX处理器共享
+     */
+    struct ImageSkipState {
+        bool armed = false;             // 下一个字符串值是 img
+        bool skipped = false;           // img 已被跳过
+        const char* begin = nullptr;    // img 内容起始位置
+        size_t length = 0;              // img 内容长度
+    };
+
+    /**
+     * @brief 供 nlohmann 词法分析器使用的输入迭代器
+     * 在 img 的起始引号处直接跳到结束引号，词法分析器只会看到空字符串；
+     * 内容含转义或控制字符时不跳过，交给词法分析器按标准规则处理
+     */
+    class SkippingIterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = char;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const char*;
+        using reference = const char&;
+
+        SkippingIterator(const char* position, const char* end, ImageSkipState* state)
+                : position_(position), end_(end), state_(state) {}
+
+        reference operator*() const { return *position_; }
+
+        SkippingIterator& operator++() {
+            if (state_->armed) {
+                advanceArmed();
+            } else {
+                ++position_;
+            }
+            return *this;
+        }
+
+        bool operator==(const SkippingIterator& other) const { return position_ == other.position_; }
+
+        bool operator!=(const SkippingIterator& other) const { return position_ != other.position_; }
+
+    private:
+        void advanceArmed() {
+            char current = *position_;
+            if (current == ' ' || current == '\t' || current == '\n' || current == '\r' || current == ':') {
+                ++position_;
+                return;
+            }
+
+            state_->armed = false;
+            if (current != '"') {
+                ++position_; // img 不是字符串，交给处理器报告类型错误
+                return;
+            }
+
+            const char* contentBegin = position_ + 1;
+            const char* scan = contentBegin;
+            while (scan < end_) {
+                auto c = static_cast<unsigned char>(*scan);
+                if (c == '"' || c == '\\' || c < 0x20) {
+                    break;
+                }
+                ++scan;
+            }
+
+            if (scan < end_ && *scan == '"') {
+                state_->skipped = true;
+                state_->begin = contentBegin;
+                state_->length = static_cast<size_t>(scan - contentBegin);
+                position_ = scan; // 下一个字符即结束引号
+            } else {
+                ++position_;
+            }
+        }
+
+        const char* position_;
+        const char* end_;
+        ImageSkipState* state_;
+    };
+
+    /**
+     * @brief 只关心顶层字段的SAX处理器
+     */
+    class InferenceRequestSax {
+    public:
+        using number_integer_t = json::number_integer_t;
+        using number_unsigned_t = json::number_unsigned_t;
+        using number_float_t = json::number_float_t;
+        using string_t = json::string_t;
+        using binary_t = json::binary_t;
+
+        InferenceRequestSax(Handlers::InferenceRequest& request, ImageSkipState& state)
+                : request_(request), state_(state) {}
+
+        bool null() {
+            assignOther();
+            return true;
+        }
+
+        bool boolean(bool) {
+            assignOther();
+            return true;
+        }
+
+        bool number_integer(number_integer_t value) {
+            assignNumber(static_cast<double>(value), true);
+            return true;
+        }
+
+        bool number_unsigned(number_unsigned_t value) {
+            assignNumber(static_cast<double>(value), true);
+            return true;
+        }
+
+        bool number_float(number_float_t value, const string_t&) {
+            assignNumber(value, false);
+            return true;
+        }
+
+        bool string(string_t& value) {
+            if (depth_ != 1) {
+                return true;
+            }
+            if (currentKey_ == Key::IMG) {
+                request_.hasImage = true;
+                request_.imageIsString = true;
+                if (state_.skipped) {
+                    request_.image = std::string_view(state_.begin, state_.length);
+                    request_.imageStorage.clear();
+                } else {
+                    // 含转义字符，保留反转义后的副本
+                    request_.imageStorage = std::move(value);
+                    request_.image = request_.imageStorage;
+                }
+                state_.skipped = false;
+            } else {
+                assignOther();
+            }
+            return true;
+        }
+
+        bool binary(binary_t&) {
+            assignOther();
+            return true;
+        }
+
+        bool start_object(std::size_t) {
+            assignOther();
+            depth_++;
+            return true;
+        }
+
+        bool end_object() {
+            depth_--;
+            return true;
+        }
+
+        bool start_array(std::size_t) {
+            assignOther();
+            depth_++;
+            return true;
+        }
+
+        bool end_array() {
+            depth_--;
+            return true;
+        }
+
+        bool key(string_t& value) {
+            if (depth_ != 1) {
+                return true;
+            }
+            currentKey_ = keyOf(value);
+            state_.armed = currentKey_ == Key::IMG;
+            state_.skipped = false;
+            return true;
+        }
+
+        bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& ex) {
+            error_ = ex.what();
+            return false;
+        }
+
+        const std::string& error() const { return error_; }
+
+    private:
+        enum class Key {
+            OTHER, IMG, MODEL_TYPE, TIMEOUT, START_VALUE, END_VALUE, PRIORITY, DEADLINE_MS
+        };
+
+        static Key keyOf(const string_t& name) {
+            if (name == "img") return Key::IMG;
+            if (name == "modelType") return Key::MODEL_TYPE;
+            if (name == "timeout") return Key::TIMEOUT;
+            if (name == "startValue") return Key::START_VALUE;
+            if (name == "endValue") return Key::END_VALUE;
+            if (name == "priority") return Key::PRIORITY;
+            if (name == "deadline_ms") return Key::DEADLINE_MS;
+            return Key::OTHER;
+        }
+
+        // 顶层数值字段，与原先DOM解析的类型判断保持一致
+        void assignNumber(double value, bool integer) {
+            if (depth_ != 1) {
+                return;
+            }
+            switch (currentKey_) {
+                case Key::IMG:
+                    request_.hasImage = true;
+                    request_.imageIsString = false;
+                    break;
+                case Key::MODEL_TYPE:
+                    request_.hasModelType = true;
+                    request_.modelTypeIsNumber = true;
+                    request_.modelType = static_cast<int>(value);
+                    break;
+                case Key::TIMEOUT:
+                    if (integer) {
+                        request_.hasTimeout = true;
+                        request_.timeout = static_cast<int>(value);
+                    }
+                    break;
+                case Key::START_VALUE:
+                    request_.hasStartValue = true;
+                    request_.startValue = value;
+                    break;
+                case Key::END_VALUE:
+                    request_.hasEndValue = true;
+                    request_.endValue = value;
+                    break;
+                case Key::PRIORITY:
+                    if (integer) {
+                        request_.hasPriority = true;
+                        request_.priority = static_cast<int>(value);
+                    }
+                    break;
+                case Key::DEADLINE_MS:
+                    if (integer) {
+                        request_.hasDeadlineMs = true;
+                        request_.deadlineMs = static_cast<int>(value);
+                    }
+                    break;
+                case Key::OTHER:
+                    break;
+            }
+        }
+
+        // 顶层非数值、非字符串字段：只记录 img / modelType 的存在
+        void assignOther() {
+            if (depth_ != 1) {
+                return;
+            }
+            if (currentKey_ == Key::IMG) {
+                request_.hasImage = true;
+                request_.imageIsString = false;
+            } else if (currentKey_ == Key::MODEL_TYPE) {
+                request_.hasModelType = true;
+                request_.modelTypeIsNumber = false;
+            }
+        }
+
+        Handlers::InferenceRequest& request_;
+        ImageSkipState& state_;
+        int depth_ = 0;
+        Key currentKey_ = Key::OTHER;
+        std::string error_;
+    };
+
+} // namespace
+
+bool Handlers::parseInferenceRequest(const std::string& body, InferenceRequest& request, std::string& error) {
+    request = InferenceRequest();
+
+    ImageSkipState state;
+    InferenceRequestSax sax(request, state);
+
+    const char* begin = body.data();
+    const char* end = begin + body.size();
+    bool ok = json::sax_parse(SkippingIterator(begin, end, &state), SkippingIterator(end, end, &state), &sax);
+    if (!ok) {
+        error = sax.error().empty() ? "unexpected end of input" : sax.error();
+        return false;
+    }
+    return true;
+}
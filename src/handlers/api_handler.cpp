@@ -112,15 +112,350 @@
 //}
 
 #include "handlers/api_handler.h"
+#include "handlers/InferenceRequestParser.h"
 #include "nlohmann/json.hpp"
 #include "exception/GlobalExceptionHandler.h"
 #include "common/base64.h"
+#include "common/JsonWriter.h"
+#include "common/FramePool.h"
 #include "opencv2/opencv.hpp"
 #include "app/ApplicationManager.h"
 #include <chrono>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
 
 using json = nlohmann::json;
 
+namespace {
+
+    /**
+     * @brief 推理请求参数（JSON 与二进制接口共用）
+     */
+    struct InferenceRequestOptions {
+        int modelType = 0;
+        int timeout = 0;
+        double startValue = 0.0;
+        double endValue = 0.0;
+        AcquirePriority priority;
+    };
+
+    /**
+     * @brief 准入控制：超出并发上限时排队等待，队列已满立即拒绝
+     */
+    AdmissionController::Permit admitOrThrow(ApplicationManager& appManager) {
+        auto permit = appManager.admitRequest();
+        if (!permit.admitted()) {
+            appManager.failHttpRequest();
+            int code = 503;
+            if (permit.status() == AdmissionController::Status::QUEUE_FULL) {
+                code = 429;
+            } else if (permit.status() == AdmissionController::Status::DEADLINE_EXCEEDED) {
+                code = 504;
+            }
+            throw APIException(AdmissionController::statusToString(permit.status()), code);
+        }
+        return permit;
+    }
+
+    /**
+     * @brief 校验模型类型，并丢弃排队期间已过期的请求
+     */
+    void validateBeforeDecode(ApplicationManager& appManager, const InferenceRequestOptions& options) {
+        if (options.modelType <= 0) {
+            appManager.failHttpRequest();
+            throw APIException("Invalid model type", 400);
+        }
+
+        if (std::chrono::steady_clock::now() >= options.priority.deadline) {
+            appManager.getAdmissionController().recordExpired();
+            appManager.failHttpRequest();
+            throw APIException("Request deadline exceeded before processing", 504);
+        }
+    }
+
+    /**
+     * @brief 推理失败时按模型池状态给出诊断信息
+     */
+    [[noreturn]] void throwInferenceFailure(ApplicationManager& appManager, int modelType) {
+        appManager.failHttpRequest();
+        auto poolStatus = appManager.getModelPoolStatus(modelType);
+        std::string errorDetail = "Model inference failed for type " + std::to_string(modelType);
+        if (poolStatus.totalModels == 0) {
+            errorDetail += " - No model instances available";
+        } else if (!poolStatus.isEnabled) {
+            errorDetail += " - Model pool is disabled";
+        } else if (poolStatus.availableModels == 0) {
+            errorDetail += " - All model instances are busy";
+        }
+        throw APIException(errorDetail, 503);
+    }
+
+    /**
+     * @brief 单遍写出推理响应（键按字母序，与 nlohmann::json 的输出一致）
+     */
+    void writeInferenceBody(ApplicationManager& appManager, int modelType, const InferenceOutput& output,
+                            long long processingMs, std::string& body) {
+        body.clear();
+        JsonWriter writer(body);
+        writer.beginObject();
+
+        // 添加并发状态信息（如果启用监控）
+        if (appManager.getConcurrencyConfig().enableConcurrencyMonitoring) {
+            auto httpStats = appManager.getHttpConcurrencyStats();
+            auto poolStatus = appManager.getModelPoolStatus(modelType);
+
+            writer.key("concurrency_info").beginObject()
+                    .key("active_http_requests").value(httpStats.active)
+                    .key("model_pool_status").beginObject()
+                    .key("available_models").value(poolStatus.availableModels)
+                    .key("busy_models").value(poolStatus.busyModels)
+                    .key("total_models").value(poolStatus.totalModels)
+                    .endObject()
+                    .key("total_http_requests").value(httpStats.total)
+                    .endObject();
+        }
+
+        // 检测结果：[[x1, y1, x2, y2, score, class_id, 附加数值...], ...]
+        writer.key("detect_results").beginArray();
+        for (size_t i = 0; i < output.size(); ++i) {
+            writer.beginArray();
+            for (size_t k = 0; k < 4; ++k) {
+                writer.value(output.boxes[i * 4 + k]);
+            }
+            writer.value(output.scores[i]).value(output.classIds[i]);
+            for (uint32_t k = output.keypointOffsets[i]; k < output.keypointOffsets[i + 1]; ++k) {
+                writer.value(output.keypoints[k]);
+            }
+            writer.endArray();
+        }
+        writer.endArray();
+
+        writer.key("detect_type").value(modelType)
+                .key("message").value("Processing completed successfully");
+
+        writer.key("plate_results").beginArray();
+        for (const auto& plate : output.plateResults) {
+            writer.value(plate);
+        }
+        writer.endArray();
+
+        writer.key("processing_time_ms").value(processingMs)
+                .key("received").value(true)
+                .key("status").value("success");
+
+        if (modelType == 5) {
+            writer.key("target_result").exactValue(output.value);
+        }
+
+        writer.endObject();
+    }
+
+    /**
+     * @brief 经分阶段流水线处理：解码、推理、序列化分别在各自的线程池中执行，当前线程只等待结果
+     * @return 序列化完成的时间
+     */
+    std::chrono::steady_clock::time_point inferThroughPipeline(ApplicationManager& appManager,
+                                                               InferencePipeline& pipeline,
+                                                               const AdmissionController::Permit& permit,
+                                                               InferenceRequestOptions& options,
+                                                               const unsigned char* data,
+                                                               size_t size,
+                                                               std::chrono::steady_clock::time_point start_time,
+                                                               StageTimings& timings,
+                                                               FramePool::Frame& frame,
+                                                               InferenceOutput& output,
+                                                               std::string& body) {
+        int modelType = options.modelType;
+        std::chrono::steady_clock::time_point serializeEnd;
+
+        InferencePipeline::Job job;
+        job.data = data;
+        job.size = size;
+        job.modelType = modelType;
+        job.inputSize = appManager.getModelInputSize(modelType);
+        job.params.startValue = options.startValue;
+        job.params.endValue = options.endValue;
+        job.timeoutMs = permit.boundTimeout(options.timeout);
+        job.priority = options.priority;
+        job.timings = &timings;
+        job.frame = &frame;
+        job.output = &output;
+        job.serialize = [&]() {
+            auto end_time = std::chrono::steady_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+            writeInferenceBody(appManager, modelType, output, duration.count(), body);
+            serializeEnd = timings.mark(LatencyStage::SERIALIZE, end_time);
+        };
+
+        auto result = pipeline.execute(job);
+        switch (result) {
+            case InferencePipeline::Result::OK:
+                break;
+            case InferencePipeline::Result::DECODE_FAILED:
+                appManager.failHttpRequest();
+                throw APIException("Image decode failed", 400);
+            case InferencePipeline::Result::EXPIRED:
+                appManager.getAdmissionController().recordExpired();
+                appManager.failHttpRequest();
+                throw APIException("Request deadline exceeded before inference", 504);
+            case InferencePipeline::Result::INFERENCE_FAILED:
+                throwInferenceFailure(appManager, modelType);
+            default:
+                appManager.failHttpRequest();
+                throw APIException(InferencePipeline::resultToString(result), 503);
+        }
+
+        LOGGER_INFO_F("Processed image request through pipeline - model_type: {}, image_size: {}x{}, decoded: {}x{}",
+                      modelType, frame.originalSize().width, frame.originalSize().height,
+                      frame.image().cols, frame.image().rows);
+        return serializeEnd;
+    }
+
+    /**
+     * @brief 解码已编码的图像字节（JPEG/PNG等），执行推理并写入响应
+     * @param data 编码后的图像数据，仅在本次调用期间被引用
+     * @param size 数据长度
+     * @param timings 已记录前序阶段的耗时，成功后连同后续阶段一起计入HTTP延迟统计
+     */
+    void inferEncodedImage(ApplicationManager& appManager,
+                           const AdmissionController::Permit& permit,
+                           InferenceRequestOptions& options,
+                           const unsigned char* data,
+                           size_t size,
+                           std::chrono::steady_clock::time_point start_time,
+                           StageTimings& timings,
+                           httplib::Response& res) {
+        if (size == 0) {
+            appManager.failHttpRequest();
+            throw APIException("Empty image data", 400);
+        }
+
+        int modelType = options.modelType;
+
+        // 结果与响应写入当前线程复用的缓冲区；解码图像在响应写出后随 frame 析构归还
+        static thread_local InferenceOutput output;
+        static thread_local std::string body;
+        FramePool::Frame frame;
+        std::chrono::steady_clock::time_point serializeEnd;
+
+        if (auto* pipeline = appManager.getPipeline()) {
+            serializeEnd = inferThroughPipeline(appManager, *pipeline, permit, options, data, size, start_time,
+                                                timings, frame, output, body);
+        } else {
+            // 远大于模型输入的JPEG降采样解码
+            auto decodeStart = std::chrono::steady_clock::now();
+            if (!FramePool::getInstance().decode(data, size, cv::IMREAD_COLOR, frame,
+                                                 appManager.getModelInputSize(modelType))) {
+                appManager.failHttpRequest();
+                throw APIException("Image decode failed", 400);
+            }
+            timings.mark(LatencyStage::IMAGE_DECODE, decodeStart);
+            const cv::Mat& ori_img = frame.image();
+
+            // 记录图像处理开始
+            LOGGER_INFO_F("Processing image request - model_type: {}, image_size: {}x{}, decoded: {}x{}",
+                          modelType, frame.originalSize().width, frame.originalSize().height, ori_img.cols, ori_img.rows);
+
+            // 模型获取超时不超过请求剩余时间
+            int timeout = options.timeout;
+            auto remainingMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    options.priority.deadline - std::chrono::steady_clock::now()).count();
+            timeout = permit.boundTimeout(timeout);
+            if (remainingMs < timeout) {
+                timeout = static_cast<int>(std::max<long long>(0, remainingMs));
+            }
+            if (timeout <= 0) {
+                appManager.getAdmissionController().recordExpired();
+                appManager.failHttpRequest();
+                throw APIException("Request deadline exceeded before inference", 504);
+            }
+
+            // 使用模型池进行推理
+            bool success = appManager.executeModelInference(modelType,
+                                                            ori_img,
+                                                            output,
+                                                            options.startValue,
+                                                            options.endValue,
+                                                            timeout,
+                                                            options.priority,
+                                                            &timings);
+            if (!success) {
+                throwInferenceFailure(appManager, modelType);
+            }
+
+            // 降采样解码时检测框换算回原图坐标
+            if (frame.reduced()) {
+                output.scaleBoxes(frame.scaleX(), frame.scaleY());
+            }
+
+            auto end_time = std::chrono::steady_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+            writeInferenceBody(appManager, modelType, output, duration.count(), body);
+            serializeEnd = timings.mark(LatencyStage::SERIALIZE, end_time);
+        }
+
+        // 发送响应
+        res.set_content(body.data(), body.size(), "application/json");
+
+        timings.set(LatencyStage::TOTAL, start_time, serializeEnd);
+        appManager.recordHttpLatency(modelType, timings);
+
+        // 记录成功处理
+        LOGGER_INFO_F("Image processing completed successfully - model_type: {}, time: {}ms",
+                      modelType, std::chrono::duration_cast<std::chrono::milliseconds>(serializeEnd - start_time).count());
+
+        // 完成请求监控
+        appManager.completeHttpRequest();
+    }
+
+    /**
+     * @brief 二进制接口的参数查找：查询参数 > multipart 文本字段 > X-* 请求头
+     */
+    bool findBinaryOption(const httplib::Request& req, const std::string& name, const std::string& header,
+                          std::string& value) {
+        if (req.has_param(name)) {
+            value = req.get_param_value(name);
+            return true;
+        }
+        auto field = req.files.find(name);
+        if (field != req.files.end() && field->second.filename.empty()) {
+            value = field->second.content;
+            return true;
+        }
+        if (req.has_header(header)) {
+            value = req.get_header_value(header);
+            return true;
+        }
+        return false;
+    }
+
+    template<typename T>
+    bool parseBinaryOption(ApplicationManager& appManager, const httplib::Request& req,
+                           const std::string& name, const std::string& header, T& out) {
+        std::string value;
+        if (!findBinaryOption(req, name, header, value)) {
+            return false;
+        }
+        try {
+            size_t pos = 0;
+            if constexpr (std::is_integral_v<T>) {
+                out = std::stoi(value, &pos);
+            } else {
+                out = std::stod(value, &pos);
+            }
+            if (pos != value.size()) {
+                throw std::invalid_argument(value);
+            }
+        } catch (const std::exception&) {
+            appManager.failHttpRequest();
+            throw APIException("Invalid value for '" + name + "': " + value, 400);
+        }
+        return true;
+    }
+
+} // namespace
+
 void Handlers::handle_api_model_process(const httplib::Request& req, httplib::Response& res) {
     ExceptionHandler::handleRequest(req, res, [](const httplib::Request& req, httplib::Response& res) {
         auto& appManager = ApplicationManager::getInstance();
@@ -130,7 +465,7 @@ void Handlers::handle_api_model_process(const httplib::Request& req, httplib::Re
 
         try {
             // 获取请求开始时间
-            auto start_time = std::chrono::high_resolution_clock::now();
+            auto start_time = std::chrono::steady_clock::now();
 
             // 检查内容类型
             if (!req.has_header("Content-Type") ||
@@ -139,170 +474,157 @@ void Handlers::handle_api_model_process(const httplib::Request& req, httplib::Re
                 throw APIException("Request must include 'application/json' Content-Type", 415);
             }
 
-            // 解析 JSON 数据
-            json received_json;
-            try {
-                received_json = json::parse(req.body);
-            } catch (const json::exception& e) {
+            auto permit = admitOrThrow(appManager);
+            StageTimings timings;
+            auto stageStart = timings.mark(LatencyStage::ADMISSION, start_time);
+
+            // SAX 解析：不构建DOM，img 仅记录其在请求体中的位置
+            InferenceRequest parsed;
+            std::string parseError;
+            if (!parseInferenceRequest(req.body, parsed, parseError)) {
                 appManager.failHttpRequest();
-                throw JSONParseException(std::string("Invalid JSON format: ") + e.what());
+                throw JSONParseException("Invalid JSON format: " + parseError);
             }
+            stageStart = timings.mark(LatencyStage::PARSE, stageStart);
 
             // 验证必要字段
-            if (!received_json.contains("img")) {
+            if (!parsed.hasImage) {
                 appManager.failHttpRequest();
                 throw APIException("Request must include 'img' field", 400);
             }
 
-            if (!received_json.contains("modelType")) {
+            if (!parsed.hasModelType) {
                 appManager.failHttpRequest();
                 throw APIException("Request must include 'modelType' field", 400);
             }
 
-            std::string message = received_json["img"];
-            int modelType = received_json["modelType"];
-
-            // 获取超时配置
-            int timeout = appManager.getConcurrencyConfig().modelAcquireTimeoutMs;
-            if (received_json.contains("timeout") && received_json["timeout"].is_number_integer()) {
-                timeout = received_json["timeout"];
+            if (!parsed.imageIsString) {
+                appManager.failHttpRequest();
+                throw APIException("'img' field must be a base64 string", 400);
             }
 
-            // 验证模型类型
-            if (modelType <= 0) {
+            if (!parsed.modelTypeIsNumber) {
                 appManager.failHttpRequest();
-                throw APIException("Invalid model type", 400);
+                throw APIException("'modelType' field must be a number", 400);
+            }
+
+            InferenceRequestOptions options;
+            options.modelType = parsed.modelType;
+
+            // 获取超时配置
+            options.timeout = parsed.hasTimeout ? parsed.timeout
+                                                : appManager.getConcurrencyConfig().modelAcquireTimeoutMs;
+
+            // 仪表读数量程（仅仪表模型使用）
+            options.startValue = parsed.startValue;
+            options.endValue = parsed.endValue;
+
+            // 调度属性：优先级越大越先获得模型实例；deadline_ms 为客户端给出的剩余时间
+            options.priority.deadline = permit.deadline();
+            options.priority.priority = parsed.priority;
+            if (parsed.hasDeadlineMs) {
+                options.priority.deadline = std::min(options.priority.deadline,
+                                                     start_time + std::chrono::milliseconds(std::max(0, parsed.deadlineMs)));
             }
 
-            // 解码Base64图像
-            std::vector<unsigned char> decoded_data;
+            validateBeforeDecode(appManager, options);
+
+            // 解码Base64图像到当前线程的复用缓冲区
+            stageStart = std::chrono::steady_clock::now();
+            std::vector<unsigned char>& decoded_data = base64_thread_buffer();
             try {
-                std::string decoded_str = base64_decode(message);
-//                decoded_data = std::vector<unsigned char>(decoded_str.begin(), decoded_str.end());
-                decoded_data.reserve(decoded_str.size());
-                decoded_data.assign(
-                        std::make_move_iterator(decoded_str.begin()),
-                        std::make_move_iterator(decoded_str.end())
-                );
+                base64_decode_into(parsed.image, decoded_data);
             } catch (const std::exception& e) {
                 appManager.failHttpRequest();
                 throw APIException("Base64 decode failed: " + std::string(e.what()), 400);
             }
+            timings.mark(LatencyStage::BASE64_DECODE, stageStart);
 
-            cv::Mat ori_img = cv::imdecode(decoded_data, cv::IMREAD_COLOR);
-            if (ori_img.empty()) {
-                appManager.failHttpRequest();
-                throw APIException("Image decode failed", 400);
-            }
-
-            // 记录图像处理开始
-            LOGGER_INFO("Processing image request - model_type: " + std::to_string(modelType) +
-                         ", image_size: " + std::to_string(ori_img.cols) + "x" + std::to_string(ori_img.rows));
+            inferEncodedImage(appManager, permit, options, decoded_data.data(), decoded_data.size(), start_time,
+                              timings, res);
 
-            // 使用模型池进行推理
-            std::vector<std::vector<std::any>> results_vector;
-            std::vector<std::string> plateResults_vector;
+        } catch (...) {
+            appManager.failHttpRequest();
+            throw; // 重新抛出异常让ExceptionHandler处理
+        }
+    });
+}
 
-            bool success = appManager.executeModelInference(modelType,
-                                                            ori_img,
-                                                            results_vector,
-                                                            plateResults_vector,
-                                                            timeout);
+void Handlers::handle_api_model_process_binary(const httplib::Request& req, httplib::Response& res) {
+    ExceptionHandler::handleRequest(req, res, [](const httplib::Request& req, httplib::Response& res) {
+        auto& appManager = ApplicationManager::getInstance();
 
-            ori_img.release();
+        // 开始请求监控
+        appManager.startHttpRequest();
 
-            if (!success) {
+        try {
+            // 获取请求开始时间
+            auto start_time = std::chrono::steady_clock::now();
+
+            // 检查内容类型：image/*、application/octet-stream 或 multipart/form-data
+            std::string contentType = req.get_header_value("Content-Type");
+            bool multipart = req.is_multipart_form_data();
+            bool rawBody = contentType.rfind("image/", 0) == 0 ||
+                           contentType.rfind("application/octet-stream", 0) == 0;
+            if (!multipart && !rawBody) {
                 appManager.failHttpRequest();
-                // 获取模型池状态用于错误诊断
-                auto poolStatus = appManager.getModelPoolStatus(modelType);
-                std::string errorDetail = "Model inference failed for type " + std::to_string(modelType);
-                if (poolStatus.totalModels == 0) {
-                    errorDetail += " - No model instances available";
-                } else if (!poolStatus.isEnabled) {
-                    errorDetail += " - Model pool is disabled";
-                } else if (poolStatus.availableModels == 0) {
-                    errorDetail += " - All model instances are busy";
-                }
-                throw APIException(errorDetail, 503);
+                throw APIException("Request must use 'image/*', 'application/octet-stream' "
+                                   "or 'multipart/form-data' Content-Type", 415);
             }
 
-            // 计算处理时间
-            auto end_time = std::chrono::high_resolution_clock::now();
-            auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
-
-            // 转换结果为JSON
-            json json_data = json::array();
-            for (const auto& inner_vec : results_vector) {
-                json inner_json = json::array();
-                for (const auto& item : inner_vec) {
-                    inner_json.push_back(any_to_json(item));
+            auto permit = admitOrThrow(appManager);
+            StageTimings timings;
+            timings.mark(LatencyStage::ADMISSION, start_time);
+
+            // 定位图像数据：原始请求体，或 multipart 中名为 image 的文件（缺省取第一个文件）
+            const std::string* body = &req.body;
+            if (multipart) {
+                auto file = req.files.find("image");
+                if (file == req.files.end()) {
+                    file = std::find_if(req.files.begin(), req.files.end(), [](const auto& item) {
+                        return !item.second.filename.empty();
+                    });
                 }
-                json_data.push_back(std::move(inner_json));
-            }
-
-            // 构建响应 JSON
-            json response_json = json::object();
-            response_json["status"] = "success";
-            response_json["message"] = "Processing completed successfully";
-            response_json["processing_time_ms"] = duration.count();
-            response_json["detect_type"] = modelType;
-            response_json["received"] = true;
-
-            // 转换检测结果 - 使用移动语义减少拷贝
-            {
-                json json_data = json::array();
-
-                for (auto& inner_vec : results_vector) {
-                    json inner_json = json::array();
-
-                    for (auto& item : inner_vec) {
-                        inner_json.push_back(any_to_json(item));
-                    }
-                    json_data.push_back(std::move(inner_json));
+                if (file == req.files.end()) {
+                    appManager.failHttpRequest();
+                    throw APIException("Multipart request must include an 'image' file", 400);
                 }
-
-                response_json["detect_results"] = std::move(json_data);
+                body = &file->second.content;
             }
 
-            // 添加车牌结果 - 使用移动语义
-            response_json["plate_results"] = std::move(plateResults_vector);
-
-            // 添加并发状态信息（如果启用监控）
-            if (appManager.getConcurrencyConfig().enableConcurrencyMonitoring) {
-                auto httpStats = appManager.getHttpConcurrencyStats();
-                auto poolStatus = appManager.getModelPoolStatus(modelType);
+            // 参数来自查询参数、multipart 文本字段或 X-* 请求头
+            InferenceRequestOptions options;
+            if (!parseBinaryOption(appManager, req, "modelType", "X-Model-Type", options.modelType)) {
+                appManager.failHttpRequest();
+                throw APIException("Request must include 'modelType' parameter or 'X-Model-Type' header", 400);
+            }
 
-                json concurrency_info = json::object();
-                concurrency_info["active_http_requests"] = httpStats.active;
-                concurrency_info["total_http_requests"] = httpStats.total;
+            options.timeout = appManager.getConcurrencyConfig().modelAcquireTimeoutMs;
+            parseBinaryOption(appManager, req, "timeout", "X-Timeout", options.timeout);
 
-                json pool_status = json::object();
-                pool_status["total_models"] = poolStatus.totalModels;
-                pool_status["available_models"] = poolStatus.availableModels;
-                pool_status["busy_models"] = poolStatus.busyModels;
+            // 仪表读数量程（仅仪表模型使用）
+            parseBinaryOption(appManager, req, "startValue", "X-Start-Value", options.startValue);
+            parseBinaryOption(appManager, req, "endValue", "X-End-Value", options.endValue);
 
-                concurrency_info["model_pool_status"] = std::move(pool_status);
-                response_json["concurrency_info"] = std::move(concurrency_info);
+            // 调度属性：优先级越大越先获得模型实例；deadline_ms 为客户端给出的剩余时间
+            options.priority.deadline = permit.deadline();
+            parseBinaryOption(appManager, req, "priority", "X-Priority", options.priority.priority);
+            int deadlineMs = 0;
+            if (parseBinaryOption(appManager, req, "deadline_ms", "X-Deadline-Ms", deadlineMs)) {
+                options.priority.deadline = std::min(options.priority.deadline,
+                                                     start_time + std::chrono::milliseconds(std::max(0, deadlineMs)));
             }
 
-            // 发送响应
-            res.set_content(response_json.dump(), "application/json");
-
-            // 记录成功处理
-            LOGGER_INFO("Image processing completed successfully - model_type: " +
-                         std::to_string(modelType) + ", time: " + std::to_string(duration.count()) + "ms");
-
-            // 完成请求监控
-            appManager.completeHttpRequest();
+            validateBeforeDecode(appManager, options);
 
-            results_vector.clear();
-            plateResults_vector.clear();
-            std::vector<std::vector<std::any>>().swap(results_vector);
-            std::vector<std::string>().swap(plateResults_vector);
+            // 图像字节直接来自请求体，无需Base64解码与拷贝
+            inferEncodedImage(appManager, permit, options,
+                              reinterpret_cast<const unsigned char*>(body->data()), body->size(),
+                              start_time, timings, res);
 
         } catch (...) {
             appManager.failHttpRequest();
             throw; // 重新抛出异常让ExceptionHandler处理
         }
     });
-}
\ No newline at end of file
+}
@@ -0,0 +1,428 @@
+//
+// Created by YJK on 2026/10/16.
+//
+
+#include "handlers/metrics_handler.h"
+#include "exception/GlobalExceptionHandler.h"
+#include "app/ApplicationManager.h"
+#include "common/Logger.h"
+#include "common/FramePool.h"
+#include "routeManager/HttpServer.h"
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+    /**
+     * @brief Prometheus 文本格式写出器，直接追加到复用的缓冲区
+     */
+    class MetricsWriter {
+    public:
+        explicit MetricsWriter(std::string& out) : out_(out) {}
+
+        void family(std::string_view name, const char* type, const char* help) {
+            out_ += "# HELP ";
+            out_ += name;
+            out_ += ' ';
+            out_ += help;
+            out_ += "\n# TYPE ";
+            out_ += name;
+            out_ += ' ';
+            out_ += type;
+            out_ += '\n';
+        }
+
+        void sample(std::string_view name, std::string_view labels, uint64_t value) {
+            beginSample(name, labels);
+            char buffer[24];
+            auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+            out_.append(buffer, result.ptr);
+            out_ += '\n';
+        }
+
+        void sample(std::string_view name, std::string_view labels, double value) {
+            beginSample(name, labels);
+            char buffer[32];
+            int length = snprintf(buffer, sizeof(buffer), "%.9g", value);
+            out_.append(buffer, std::min(static_cast<size_t>(std::max(length, 0)), sizeof(buffer) - 1));
+            out_ += '\n';
+        }
+
+    private:
+        void beginSample(std::string_view name, std::string_view labels) {
+            out_ += name;
+            if (!labels.empty()) {
+                out_ += '{';
+                out_ += labels;
+                out_ += '}';
+            }
+            out_ += ' ';
+        }
+
+        std::string& out_;
+    };
+
+    std::string modelTypeLabel(int modelType) {
+        return "model_type=\"" + std::to_string(modelType) + "\"";
+    }
+
+    // 延迟直方图的导出桶边界（秒），与内部的对数-线性分桶按上界归并
+    const double LATENCY_BUCKETS_SECONDS[] = {0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05,
+                                              0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0};
+    const char* const LATENCY_BUCKET_LABELS[] = {"0.0005", "0.001", "0.0025", "0.005", "0.01", "0.025", "0.05",
+                                                 "0.1", "0.25", "0.5", "1", "2.5", "5", "10"};
+    constexpr size_t LATENCY_BUCKET_COUNT = sizeof(LATENCY_BUCKETS_SECONDS) / sizeof(LATENCY_BUCKETS_SECONDS[0]);
+
+    void writeRequestMetrics(MetricsWriter& writer, ApplicationManager& appManager) {
+        auto httpStats = appManager.getHttpConcurrencyStats();
+        auto grpcStats = appManager.getGrpcConcurrencyStats();
+
+        writer.family("http_model_requests_active", "gauge", "Inference requests currently being processed");
+        writer.sample("http_model_requests_active", "protocol=\"http\"", static_cast<uint64_t>(std::max(0, httpStats.active)));
+        writer.sample("http_model_requests_active", "protocol=\"grpc\"", static_cast<uint64_t>(std::max(0, grpcStats.active)));
+
+        writer.family("http_model_requests_total", "counter", "Inference requests received");
+        writer.sample("http_model_requests_total", "protocol=\"http\"", static_cast<uint64_t>(httpStats.total));
+        writer.sample("http_model_requests_total", "protocol=\"grpc\"", static_cast<uint64_t>(grpcStats.total));
+
+        writer.family("http_model_requests_failed_total", "counter", "Inference requests that failed");
+        writer.sample("http_model_requests_failed_total", "protocol=\"http\"", static_cast<uint64_t>(httpStats.failed));
+        writer.sample("http_model_requests_failed_total", "protocol=\"grpc\"", static_cast<uint64_t>(grpcStats.failed));
+    }
+
+    void writeAdmissionMetrics(MetricsWriter& writer, ApplicationManager& appManager) {
+        auto stats = appManager.getAdmissionController().getStats();
+
+        writer.family("http_model_admission_active", "gauge", "Requests holding an admission permit");
+        writer.sample("http_model_admission_active", "", static_cast<uint64_t>(std::max(0, stats.active)));
+
+        writer.family("http_model_admission_queued", "gauge", "Requests waiting for admission");
+        writer.sample("http_model_admission_queued", "", static_cast<uint64_t>(std::max(0, stats.queued)));
+
+        writer.family("http_model_admission_requests_total", "counter", "Admission decisions by result");
+        writer.sample("http_model_admission_requests_total", "result=\"admitted\"", static_cast<uint64_t>(stats.admitted));
+        writer.sample("http_model_admission_requests_total", "result=\"rejected\"", static_cast<uint64_t>(stats.rejected));
+        writer.sample("http_model_admission_requests_total", "result=\"timed_out\"", static_cast<uint64_t>(stats.timedOut));
+        writer.sample("http_model_admission_requests_total", "result=\"expired\"", static_cast<uint64_t>(stats.expired));
+    }
+
+    void writePoolMetrics(MetricsWriter& writer, ApplicationManager& appManager) {
+        // 模型池表只取共享锁；按模型类型排序使输出稳定
+        auto statusMap = appManager.getAllModelPoolStatus();
+        std::vector<std::pair<int, ModelPool::PoolStatus>> pools(statusMap.begin(), statusMap.end());
+        std::sort(pools.begin(), pools.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        std::vector<std::string> labels;
+        labels.reserve(pools.size());
+        for (const auto& pool : pools) {
+            labels.push_back(modelTypeLabel(pool.first));
+        }
+
+        writer.family("http_model_pool_instances", "gauge", "Model instances in the pool by state");
+        for (size_t i = 0; i < pools.size(); ++i) {
+            writer.sample("http_model_pool_instances", labels[i] + ",state=\"busy\"",
+                          static_cast<uint64_t>(pools[i].second.busyModels));
+            writer.sample("http_model_pool_instances", labels[i] + ",state=\"available\"",
+                          static_cast<uint64_t>(pools[i].second.availableModels));
+        }
+
+        writer.family("http_model_pool_enabled", "gauge", "Whether the model pool accepts requests");
+        for (size_t i = 0; i < pools.size(); ++i) {
+            writer.sample("http_model_pool_enabled", labels[i], static_cast<uint64_t>(pools[i].second.isEnabled ? 1 : 0));
+        }
+
+        writer.family("http_model_pool_acquires_total", "counter", "Model instance acquire attempts");
+        for (size_t i = 0; i < pools.size(); ++i) {
+            writer.sample("http_model_pool_acquires_total", labels[i], static_cast<uint64_t>(pools[i].second.totalAcquires));
+        }
+
+        writer.family("http_model_pool_releases_total", "counter", "Model instance releases");
+        for (size_t i = 0; i < pools.size(); ++i) {
+            writer.sample("http_model_pool_releases_total", labels[i], static_cast<uint64_t>(pools[i].second.totalReleases));
+        }
+
+        writer.family("http_model_pool_acquire_timeouts_total", "counter", "Model instance acquires that timed out");
+        for (size_t i = 0; i < pools.size(); ++i) {
+            writer.sample("http_model_pool_acquire_timeouts_total", labels[i], static_cast<uint64_t>(pools[i].second.timeoutCount));
+        }
+
+        writer.family("http_model_pool_acquire_rejected_total", "counter", "Model instance acquires rejected because max_queue was reached");
+        for (size_t i = 0; i < pools.size(); ++i) {
+            writer.sample("http_model_pool_acquire_rejected_total", labels[i], static_cast<uint64_t>(pools[i].second.rejectedCount));
+        }
+
+        writer.family("http_model_pool_waiting_requests", "gauge", "Requests parked waiting for a model instance");
+        for (size_t i = 0; i < pools.size(); ++i) {
+            writer.sample("http_model_pool_waiting_requests", labels[i], static_cast<uint64_t>(pools[i].second.waitingRequests));
+        }
+
+        writer.family("http_model_pool_scale_events_total", "counter", "Elastic pool instance additions and retirements");
+        for (size_t i = 0; i < pools.size(); ++i) {
+            if (!pools[i].second.elastic) {
+                continue;
+            }
+            writer.sample("http_model_pool_scale_events_total", labels[i] + ",direction=\"up\"", pools[i].second.scaleUps);
+            writer.sample("http_model_pool_scale_events_total", labels[i] + ",direction=\"down\"", pools[i].second.scaleDowns);
+        }
+
+        writer.family("http_model_pool_working_set_trims_total", "counter", "Idle instances whose working set memory was released");
+        for (size_t i = 0; i < pools.size(); ++i) {
+            writer.sample("http_model_pool_working_set_trims_total", labels[i], pools[i].second.trimCount);
+        }
+
+        writer.family("http_model_pool_busy_seconds_total", "counter", "Cumulative time model instances were held");
+        for (size_t i = 0; i < pools.size(); ++i) {
+            writer.sample("http_model_pool_busy_seconds_total", labels[i], pools[i].second.busyTimeSeconds);
+        }
+
+        writer.family("http_model_pool_utilization", "gauge", "Time-weighted instance utilization since pool start");
+        for (size_t i = 0; i < pools.size(); ++i) {
+            writer.sample("http_model_pool_utilization", labels[i], pools[i].second.utilization);
+        }
+
+        writer.family("http_model_pool_acquire_wait_seconds", "summary", "Wait time of successful instance acquires");
+        for (size_t i = 0; i < pools.size(); ++i) {
+            const auto& wait = pools[i].second.acquireWait;
+            const std::pair<const char*, uint64_t> quantiles[] = {
+                    {"0.5", wait.p50Us}, {"0.9", wait.p90Us}, {"0.99", wait.p99Us}, {"0.999", wait.p999Us}
+            };
+            for (const auto& quantile : quantiles) {
+                writer.sample("http_model_pool_acquire_wait_seconds",
+                              labels[i] + ",quantile=\"" + quantile.first + "\"",
+                              static_cast<double>(quantile.second) / 1e6);
+            }
+            writer.sample("http_model_pool_acquire_wait_seconds_sum", labels[i], pools[i].second.totalWaitSeconds);
+            writer.sample("http_model_pool_acquire_wait_seconds_count", labels[i], wait.count);
+        }
+
+        writer.family("http_model_instance_acquires_total", "counter", "Acquires served by each model instance");
+        for (size_t i = 0; i < pools.size(); ++i) {
+            for (const auto& instance : pools[i].second.instances) {
+                writer.sample("http_model_instance_acquires_total",
+                              labels[i] + ",instance=\"" + std::to_string(instance.index) + "\"",
+                              instance.acquireCount);
+            }
+        }
+
+        writer.family("http_model_instance_busy_seconds_total", "counter", "Cumulative time each model instance was held");
+        for (size_t i = 0; i < pools.size(); ++i) {
+            for (const auto& instance : pools[i].second.instances) {
+                writer.sample("http_model_instance_busy_seconds_total",
+                              labels[i] + ",instance=\"" + std::to_string(instance.index) + "\"",
+                              instance.busyTimeSeconds);
+            }
+        }
+
+        auto batchStats = appManager.getAllBatchSchedulerStats();
+        if (batchStats.empty()) {
+            return;
+        }
+        std::vector<std::pair<int, BatchScheduler::Stats>> batches(batchStats.begin(), batchStats.end());
+        std::sort(batches.begin(), batches.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        writer.family("http_model_batch_queued_requests", "gauge", "Requests waiting to be batched");
+        for (const auto& batch : batches) {
+            writer.sample("http_model_batch_queued_requests", modelTypeLabel(batch.first),
+                          static_cast<uint64_t>(batch.second.queuedRequests));
+        }
+
+        writer.family("http_model_batches_total", "counter", "Batched inference runs");
+        for (const auto& batch : batches) {
+            writer.sample("http_model_batches_total", modelTypeLabel(batch.first),
+                          static_cast<uint64_t>(batch.second.totalBatches));
+        }
+
+        writer.family("http_model_batched_requests_total", "counter", "Requests served by batched inference");
+        for (const auto& batch : batches) {
+            writer.sample("http_model_batched_requests_total", modelTypeLabel(batch.first),
+                          static_cast<uint64_t>(batch.second.totalBatchedRequests));
+        }
+
+        writer.family("http_model_batch_rejected_total", "counter", "Requests rejected because the batch queue was full");
+        for (const auto& batch : batches) {
+            writer.sample("http_model_batch_rejected_total", modelTypeLabel(batch.first),
+                          static_cast<uint64_t>(batch.second.rejectedRequests));
+        }
+    }
+
+    /**
+     * @brief 各阶段延迟：总体为直方图，按模型类型为分位数摘要
+     */
+    void writeFramePoolMetrics(MetricsWriter& writer) {
+        auto stats = FramePool::getInstance().getStats();
+
+        writer.family("http_model_frame_pool_decodes_total", "counter", "Image decodes by frame buffer source");
+        writer.sample("http_model_frame_pool_decodes_total", "source=\"reused\"", stats.hits);
+        writer.sample("http_model_frame_pool_decodes_total", "source=\"allocated\"", stats.misses);
+        writer.sample("http_model_frame_pool_decodes_total", "source=\"unpooled\"", stats.unpooled);
+
+        writer.family("http_model_frame_pool_reduced_decodes_total", "counter", "JPEG images decoded at 1/2, 1/4 or 1/8 scale");
+        writer.sample("http_model_frame_pool_reduced_decodes_total", "", stats.reduced);
+
+        writer.family("http_model_frame_pool_evictions_total", "counter", "Returned frame buffers freed because the cache limit was reached");
+        writer.sample("http_model_frame_pool_evictions_total", "", stats.evictions);
+
+        writer.family("http_model_frame_pool_cached_bytes", "gauge", "Bytes held by idle frame buffers");
+        writer.sample("http_model_frame_pool_cached_bytes", "", static_cast<uint64_t>(stats.cachedBytes));
+
+        writer.family("http_model_frame_pool_leased_buffers", "gauge", "Frame buffers currently holding a decoded image");
+        writer.sample("http_model_frame_pool_leased_buffers", "", static_cast<uint64_t>(stats.leasedBuffers));
+    }
+
+    void writePipelineMetrics(MetricsWriter& writer, ApplicationManager& appManager) {
+        auto* pipeline = appManager.getPipeline();
+        if (pipeline == nullptr) {
+            return;
+        }
+        auto stats = pipeline->getStats();
+
+        writer.family("http_model_pipeline_requests_total", "counter", "Requests handled by the staged inference pipeline");
+        writer.sample("http_model_pipeline_requests_total", "result=\"completed\"", stats.completed);
+        writer.sample("http_model_pipeline_requests_total", "result=\"failed\"", stats.failed);
+        writer.sample("http_model_pipeline_requests_total", "result=\"rejected\"", stats.rejected);
+
+        auto stageLabels = [](const InferencePipeline::StageStats& stage) {
+            std::string labels = "stage=\"" + stage.stage + "\"";
+            if (stage.modelType >= 0) {
+                labels += "," + modelTypeLabel(stage.modelType);
+            }
+            return labels;
+        };
+
+        writer.family("http_model_pipeline_queue_depth", "gauge", "Requests waiting in each pipeline stage queue");
+        for (const auto& stage : stats.stages) {
+            writer.sample("http_model_pipeline_queue_depth", stageLabels(stage), static_cast<uint64_t>(stage.queued));
+        }
+
+        writer.family("http_model_pipeline_queue_capacity", "gauge", "Capacity of each pipeline stage queue");
+        for (const auto& stage : stats.stages) {
+            writer.sample("http_model_pipeline_queue_capacity", stageLabels(stage), static_cast<uint64_t>(stage.capacity));
+        }
+
+        writer.family("http_model_pipeline_stage_processed_total", "counter", "Requests processed by each pipeline stage");
+        for (const auto& stage : stats.stages) {
+            writer.sample("http_model_pipeline_stage_processed_total", stageLabels(stage), stage.processed);
+        }
+    }
+
+    void writeHttpConnectionMetrics(MetricsWriter& writer, ApplicationManager& appManager) {
+        auto* httpServer = appManager.getHttpServer();
+        if (httpServer == nullptr) {
+            return;
+        }
+        auto stats = httpServer->getConnectionStats();
+
+        writer.family("http_model_http_connections_total", "counter", "HTTP connections by how the worker pool handled them");
+        writer.sample("http_model_http_connections_total", "result=\"accepted\"", stats.accepted);
+        writer.sample("http_model_http_connections_total", "result=\"rejected\"", stats.rejected);
+
+        writer.family("http_model_http_worker_threads", "gauge", "HTTP connection worker threads");
+        writer.sample("http_model_http_worker_threads", "", static_cast<uint64_t>(stats.threads));
+
+        writer.family("http_model_http_busy_workers", "gauge", "HTTP worker threads currently serving a connection");
+        writer.sample("http_model_http_busy_workers", "", static_cast<uint64_t>(stats.busy));
+
+        writer.family("http_model_http_queued_connections", "gauge", "HTTP connections waiting for a worker thread");
+        writer.sample("http_model_http_queued_connections", "", static_cast<uint64_t>(stats.queued));
+    }
+
+    void writeLatencyMetrics(MetricsWriter& writer, ApplicationManager& appManager) {
+        const std::pair<const char*, const ConcurrencyMonitor*> monitors[] = {
+                {"http", appManager.getHttpMonitor()},
+                {"grpc", appManager.getGrpcMonitor()}
+        };
+
+        writer.family("http_model_stage_duration_seconds", "histogram",
+                      "Latency of successful inference requests by processing stage");
+        std::string labels;
+        for (const auto& monitor : monitors) {
+            if (!monitor.second) {
+                continue;
+            }
+            for (size_t s = 0; s < ConcurrencyMonitor::STAGE_COUNT; ++s) {
+                auto stage = static_cast<LatencyStage>(s);
+                const LatencyHistogram& histogram = monitor.second->stageHistogram(stage);
+                if (histogram.count() == 0) {
+                    continue;
+                }
+
+                uint64_t bins[LATENCY_BUCKET_COUNT + 1] = {0};
+                histogram.forEachBucket([&bins](uint64_t upperUs, uint64_t n) {
+                    size_t i = 0;
+                    while (i < LATENCY_BUCKET_COUNT && static_cast<double>(upperUs) > LATENCY_BUCKETS_SECONDS[i] * 1e6) {
+                        ++i;
+                    }
+                    bins[i] += n;
+                });
+
+                std::string base = std::string("protocol=\"") + monitor.first + "\",stage=\"" + latencyStageName(stage) + "\"";
+                uint64_t cumulative = 0;
+                for (size_t i = 0; i < LATENCY_BUCKET_COUNT; ++i) {
+                    cumulative += bins[i];
+                    labels = base + ",le=\"" + LATENCY_BUCKET_LABELS[i] + "\"";
+                    writer.sample("http_model_stage_duration_seconds_bucket", labels, cumulative);
+                }
+                cumulative += bins[LATENCY_BUCKET_COUNT];
+                writer.sample("http_model_stage_duration_seconds_bucket", base + ",le=\"+Inf\"", cumulative);
+                writer.sample("http_model_stage_duration_seconds_sum", base,
+                              static_cast<double>(histogram.sumMicros()) / 1e6);
+                writer.sample("http_model_stage_duration_seconds_count", base, cumulative);
+            }
+        }
+
+        writer.family("http_model_stage_duration_by_model_seconds", "summary",
+                      "Latency quantiles of successful inference requests by stage and model type");
+        for (const auto& monitor : monitors) {
+            if (!monitor.second) {
+                continue;
+            }
+            for (const auto& latency : monitor.second->getLatencyStats()) {
+                if (latency.modelType < 0) {
+                    continue;
+                }
+                const auto& snap = latency.snapshot;
+                std::string base = std::string("protocol=\"") + monitor.first + "\",stage=\"" +
+                                   latencyStageName(latency.stage) + "\"," + modelTypeLabel(latency.modelType);
+                const std::pair<const char*, uint64_t> quantiles[] = {
+                        {"0.5", snap.p50Us}, {"0.9", snap.p90Us}, {"0.99", snap.p99Us}, {"0.999", snap.p999Us}
+                };
+                for (const auto& quantile : quantiles) {
+                    writer.sample("http_model_stage_duration_by_model_seconds",
+                                  base + ",quantile=\"" + quantile.first + "\"",
+                                  static_cast<double>(quantile.second) / 1e6);
+                }
+                writer.sample("http_model_stage_duration_by_model_seconds_sum", base,
+                              snap.meanUs * static_cast<double>(snap.count) / 1e6);
+                writer.sample("http_model_stage_duration_by_model_seconds_count", base, snap.count);
+            }
+        }
+    }
+
+} // namespace
+
+void Handlers::handle_metrics(const httplib::Request& req, httplib::Response& res) {
+    ExceptionHandler::handleRequest(req, res, [](const httplib::Request& req, httplib::Response& res) {
+        auto& appManager = ApplicationManager::getInstance();
+
+        static thread_local std::string body;
+        body.clear();
+        MetricsWriter writer(body);
+
+        writeRequestMetrics(writer, appManager);
+        writeAdmissionMetrics(writer, appManager);
+        writePoolMetrics(writer, appManager);
+        writeFramePoolMetrics(writer);
+        writePipelineMetrics(writer, appManager);
+        writeHttpConnectionMetrics(writer, appManager);
+        writeLatencyMetrics(writer, appManager);
+
+        writer.family("http_model_logger_dropped_messages_total", "counter",
+                      "Log messages dropped because a logger ring buffer was full");
+        writer.sample("http_model_logger_dropped_messages_total", "", Logger::getDroppedCount());
+
+        res.set_content(body.data(), body.size(), "text/plain; version=0.0.4; charset=utf-8");
+    });
+}
@@ -7,9 +7,40 @@
 #include "exception/GlobalExceptionHandler.h"
 #include "app/ApplicationManager.h"
 #include "grpc/GrpcServer.h"
+#include "routeManager/HttpServer.h"
 
 using json = nlohmann::json;
 
+namespace {
+
+    /**
+     * @brief 各阶段延迟分布：stages 为总体，by_model_type 按模型类型分组（单位：微秒）
+     */
+    json latencyToJson(const std::vector<ConcurrencyMonitor::LatencyStats>& latencies) {
+        json stages = json::object();
+        json byModelType = json::object();
+        for (const auto& latency : latencies) {
+            const auto& snap = latency.snapshot;
+            json item = {
+                    {"count", snap.count},
+                    {"mean_us", snap.meanUs},
+                    {"p50_us", snap.p50Us},
+                    {"p90_us", snap.p90Us},
+                    {"p99_us", snap.p99Us},
+                    {"p999_us", snap.p999Us},
+                    {"max_us", snap.maxUs}
+            };
+            if (latency.modelType < 0) {
+                stages[latencyStageName(latency.stage)] = std::move(item);
+            } else {
+                byModelType[std::to_string(latency.modelType)][latencyStageName(latency.stage)] = std::move(item);
+            }
+        }
+        return {{"stages", stages}, {"by_model_type", byModelType}};
+    }
+
+} // namespace
+
 void Handlers::handle_system_status(const httplib::Request& req, httplib::Response& res) {
     ExceptionHandler::handleRequest(req, res, [](const httplib::Request& req, httplib::Response& res) {
         auto& appManager = ApplicationManager::getInstance();
@@ -33,6 +64,7 @@ void Handlers::handle_system_status(const httplib::Request& req, httplib::Respon
                            }},
                 {"concurrency_config", {
                                    {"max_concurrent_requests", concurrencyConfig.maxConcurrentRequests},
+                                   {"max_queued_requests", concurrencyConfig.maxQueuedRequests},
                                    {"model_pool_size", concurrencyConfig.modelPoolSize},
                                    {"request_timeout_ms", concurrencyConfig.requestTimeoutMs},
                                    {"model_acquire_timeout_ms", concurrencyConfig.modelAcquireTimeoutMs},
@@ -85,22 +117,76 @@ void Handlers::handle_model_pools_status(const httplib::Request& req, httplib::R
             int modelType = pair.first;
             const auto& status = pair.second;
 
+            json instances = json::array();
+            for (const auto& instance : status.instances) {
+                instances.push_back({
+                                            {"index", instance.index},
+                                            {"busy", instance.busy},
+                                            {"acquire_count", instance.acquireCount},
+                                            {"busy_time_seconds", instance.busyTimeSeconds}
+                                    });
+            }
+
             response_json["model_pools"][std::to_string(modelType)] = {
                     {"model_type", modelType},
                     {"enabled", status.isEnabled},
                     {"model_path", status.modelPath},
+                    {"backend", status.backend},
                     {"threshold", status.threshold},
                     {"pool_info", {
                                            {"total_models", status.totalModels},
                                            {"available_models", status.availableModels},
-                                           {"busy_models", status.busyModels}
+                                           {"busy_models", status.busyModels},
+                                           {"waiting_requests", status.waitingRequests},
+                                           {"max_queue", status.maxWaiters},
+                                           {"rejected_requests", status.rejectedCount},
+                                           {"elastic", status.elastic},
+                                           {"min_instances", status.minInstances},
+                                           {"max_instances", status.maxInstances},
+                                           {"scale_ups", status.scaleUps},
+                                           {"scale_downs", status.scaleDowns},
+                                           {"working_set_trims", status.trimCount}
                                    }},
                     {"efficiency", {
-                                           {"utilization_rate", status.totalModels > 0 ?
-                                                                (double)status.busyModels / status.totalModels : 0.0},
+                                           // 时间加权利用率（自池初始化起），不再是调用瞬间的忙碌比例
+                                           {"utilization_rate", status.utilization},
+                                           {"busy_time_seconds", status.busyTimeSeconds},
+                                           {"uptime_seconds", status.uptimeSeconds},
                                            {"availability_rate", status.totalModels > 0 ?
                                                                  (double)status.availableModels / status.totalModels : 0.0}
-                                   }}
+                                   }},
+                    {"acquire_wait", {
+                                           {"count", status.acquireWait.count},
+                                           {"total_seconds", status.totalWaitSeconds},
+                                           {"mean_us", status.acquireWait.meanUs},
+                                           {"p50_us", status.acquireWait.p50Us},
+                                           {"p90_us", status.acquireWait.p90Us},
+                                           {"p99_us", status.acquireWait.p99Us},
+                                           {"p999_us", status.acquireWait.p999Us},
+                                           {"max_us", status.acquireWait.maxUs},
+                                           {"timeouts", status.timeoutCount}
+                                   }},
+                    {"instances", instances}
+            };
+        }
+
+        // 动态批处理统计
+        auto allBatchStats = appManager.getAllBatchSchedulerStats();
+        for (const auto& pair : allBatchStats) {
+            auto key = std::to_string(pair.first);
+            if (!response_json["model_pools"].contains(key)) {
+                continue;
+            }
+            const auto& stats = pair.second;
+            response_json["model_pools"][key]["batching"] = {
+                    {"max_batch_size", stats.maxBatchSize},
+                    {"max_wait_ms", stats.maxWaitMs},
+                    {"queued_requests", stats.queuedRequests},
+                    {"total_batches", stats.totalBatches},
+                    {"total_batched_requests", stats.totalBatchedRequests},
+                    {"average_batch_size", stats.averageBatchSize},
+                    {"max_queue", stats.maxQueue},
+                    {"rejected_requests", stats.rejectedRequests}
             };
         }
 
@@ -114,6 +200,7 @@ void Handlers::handle_concurrency_stats(const httplib::Request& req, httplib::Re
 
         auto httpStats = appManager.getHttpConcurrencyStats();
         auto grpcStats = appManager.getGrpcConcurrencyStats();
+        auto admissionStats = appManager.getAdmissionController().getStats();
 
         json response_json = {
                 {"status", "success"},
@@ -124,7 +211,8 @@ void Handlers::handle_concurrency_stats(const httplib::Request& req, httplib::Re
                                    {"failed_requests", httpStats.failed},
                                    {"success_requests", httpStats.total - httpStats.failed},
                                    {"failure_rate", httpStats.failureRate},
-                                   {"success_rate", 1.0 - httpStats.failureRate}
+                                   {"success_rate", 1.0 - httpStats.failureRate},
+                                   {"latency", latencyToJson(appManager.getHttpLatencyStats())}
                            }},
                 {"grpc_concurrency", {
                                    {"active_requests", grpcStats.active},
@@ -132,7 +220,8 @@ void Handlers::handle_concurrency_stats(const httplib::Request& req, httplib::Re
                                    {"failed_requests", grpcStats.failed},
                                    {"success_requests", grpcStats.total - grpcStats.failed},
                                    {"failure_rate", grpcStats.failureRate},
-                                   {"success_rate", 1.0 - grpcStats.failureRate}
+                                   {"success_rate", 1.0 - grpcStats.failureRate},
+                                   {"latency", latencyToJson(appManager.getGrpcLatencyStats())}
                            }},
                 {"combined_stats", {
                                    {"total_active", httpStats.active + grpcStats.active},
@@ -140,9 +229,59 @@ void Handlers::handle_concurrency_stats(const httplib::Request& req, httplib::Re
                                    {"total_failed", httpStats.failed + grpcStats.failed},
                                    {"overall_failure_rate", (httpStats.total + grpcStats.total) > 0 ?
                                                             (double)(httpStats.failed + grpcStats.failed) / (httpStats.total + grpcStats.total) : 0.0}
+                           }},
+                {"admission", {
+                                   {"active_requests", admissionStats.active},
+                                   {"queued_requests", admissionStats.queued},
+                                   {"max_concurrent_requests", admissionStats.maxConcurrent},
+                                   {"max_queued_requests", admissionStats.maxQueued},
+                                   {"admitted_requests", admissionStats.admitted},
+                                   {"rejected_requests", admissionStats.rejected},
+                                   {"timed_out_requests", admissionStats.timedOut},
+                                   {"expired_requests", admissionStats.expired}
                            }}
         };
 
+        // 分阶段流水线：各阶段的队列深度
+        if (auto* pipeline = appManager.getPipeline()) {
+            auto pipelineStats = pipeline->getStats();
+            json stages = json::array();
+            for (const auto& stage : pipelineStats.stages) {
+                json item = {
+                        {"stage", stage.stage},
+                        {"queued", stage.queued},
+                        {"capacity", stage.capacity},
+                        {"threads", stage.threads},
+                        {"processed", stage.processed}
+                };
+                if (stage.modelType >= 0) {
+                    item["model_type"] = stage.modelType;
+                }
+                stages.push_back(std::move(item));
+            }
+            response_json["pipeline"] = {
+                    {"running", pipelineStats.running},
+                    {"submitted_requests", pipelineStats.submitted},
+                    {"rejected_requests", pipelineStats.rejected},
+                    {"completed_requests", pipelineStats.completed},
+                    {"failed_requests", pipelineStats.failed},
+                    {"stages", stages}
+            };
+        }
+
+        // HTTP连接处理：工作线程与等待队列
+        if (auto* httpServer = appManager.getHttpServer()) {
+            auto connectionStats = httpServer->getConnectionStats();
+            response_json["http_connections"] = {
+                    {"worker_threads", connectionStats.threads},
+                    {"busy_workers", connectionStats.busy},
+                    {"queued_connections", connectionStats.queued},
+                    {"max_queued_connections", connectionStats.maxQueued},
+                    {"accepted_connections", connectionStats.accepted},
+                    {"rejected_connections", connectionStats.rejected}
+            };
+        }
+
         res.set_content(response_json.dump(2), "application/json");
     });
 }
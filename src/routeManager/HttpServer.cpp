@@ -3,11 +3,13 @@
 //
 #include "routeManager/HttpServer.h"
 #include "nlohmann/json.hpp"
+#include <algorithm>
 
 using json = nlohmann::json;
 
 HttpServer::HttpServer(const HTTPServerConfig& serverConfig)
-        : config(serverConfig), running(false) {
+        : config(serverConfig), running(false),
+          connectionCounters(std::make_shared<HttpTaskQueue::Counters>()) {
     // 初始化服务器
 }
 
@@ -97,6 +99,28 @@ bool HttpServer::start() {
         server.set_read_timeout(config.readTimeout);
     }
 
+    applyConnectionOptions();
+
+    // 在调用线程中绑定端口，记下监听套接字以便调整监听队列长度
+    socket_t listenSocket = INVALID_SOCKET;
+    server.set_socket_options([&listenSocket](socket_t sock) {
+        httplib::default_socket_options(sock);
+        listenSocket = sock;
+    });
+    bool bound = server.bind_to_port(config.host, config.port);
+    server.set_socket_options(httplib::default_socket_options);
+    if (!bound) {
+        Logger::error("Failed to bind HTTP server to " + config.host + ":" + std::to_string(config.port));
+        return false;
+    }
+
+    // httplib 以编译期常量 CPPHTTPLIB_LISTEN_BACKLOG 调用 listen，对已监听的套接字再次 listen 可调整队列长度
+    if (config.listenBacklog > 0 && listenSocket != INVALID_SOCKET) {
+        if (::listen(listenSocket, config.listenBacklog) != 0) {
+            Logger::warning("Failed to set HTTP listen backlog to " + std::to_string(config.listenBacklog));
+        }
+    }
+
     // 在新线程中启动服务器
     serverStarted = false;
     serverThread = std::make_unique<std::thread>([this]() {
@@ -108,7 +132,7 @@ bool HttpServer::start() {
                                     config.host + ":" + std::to_string(config.port));
 
         // 这里会阻塞直到服务器停止
-        bool success = server.listen(config.host.c_str(), config.port);
+        bool success = server.listen_after_bind();
 
         if (!success) {
             Logger::error("HTTP server listen returned false");
@@ -147,6 +171,34 @@ bool HttpServer::start() {
 //    return true;
 }
 
+void HttpServer::applyConnectionOptions() {
+    size_t threads = config.threadPoolSize > 0 ? static_cast<size_t>(config.threadPoolSize)
+                                               : static_cast<size_t>(std::max(1, AppConfig::getThreadPoolSize()));
+    size_t maxQueued = config.maxQueuedConnections > 0 ? static_cast<size_t>(config.maxQueuedConnections) : 0;
+
+    // 替换 httplib 按 hardware_concurrency 创建的默认线程池
+    auto counters = connectionCounters;
+    counters->threads = threads;
+    counters->maxQueued = maxQueued;
+    server.new_task_queue = [threads, maxQueued, counters]() {
+        return new HttpTaskQueue(threads, maxQueued, counters);
+    };
+
+    server.set_tcp_nodelay(config.tcpNoDelay);
+    if (config.keepAliveMaxCount > 0) {
+        server.set_keep_alive_max_count(static_cast<size_t>(config.keepAliveMaxCount));
+    }
+    if (config.payloadMaxLength > 0) {
+        server.set_payload_max_length(static_cast<size_t>(config.payloadMaxLength));
+    }
+
+    Logger::info("HTTP connection handling - worker threads: " + std::to_string(threads) +
+                 ", max queued connections: " + (maxQueued > 0 ? std::to_string(maxQueued) : std::string("unlimited")) +
+                 ", tcp_nodelay: " + (config.tcpNoDelay ? "on" : "off") +
+                 ", keep-alive max count: " + std::to_string(config.keepAliveMaxCount) +
+                 ", listen backlog: " + std::to_string(config.listenBacklog));
+}
+
 void HttpServer::stop() {
     if (!running) {
         return;
@@ -174,6 +226,17 @@ const std::vector<HttpServer::RouteInfo>& HttpServer::getRoutes() const {
     return routes;
 }
 
+HttpServer::ConnectionStats HttpServer::getConnectionStats() const {
+    ConnectionStats stats;
+    stats.threads = connectionCounters->threads.load();
+    stats.busy = connectionCounters->busy.load();
+    stats.queued = connectionCounters->queued.load();
+    stats.maxQueued = connectionCounters->maxQueued.load();
+    stats.accepted = connectionCounters->accepted.load(std::memory_order_relaxed);
+    stats.rejected = connectionCounters->rejected.load(std::memory_order_relaxed);
+    return stats;
+}
+
 void HttpServer::wait() {
     if (serverThread && serverThread->joinable()) {
         serverThread->join();
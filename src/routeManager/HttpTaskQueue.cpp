@@ -0,0 +1,57 @@
+//
+// Created by YJK on 2026/10/16.
+//
+
+#include "routeManager/HttpTaskQueue.h"
+#include <algorithm>
+#include <limits>
+
+HttpTaskQueue::HttpTaskQueue(size_t threadCount, size_t maxQueued, std::shared_ptr<Counters> counters)
+        : counters_(std::move(counters)),
+          queue_(maxQueued > 0 ? maxQueued : std::numeric_limits<size_t>::max()) {
+    threadCount = std::max<size_t>(1, threadCount);
+
+    for (size_t i = 0; i < threadCount; ++i) {
+        workers_.emplace_back(&HttpTaskQueue::workerLoop, this);
+    }
+}
+
+HttpTaskQueue::~HttpTaskQueue() {
+    shutdown();
+}
+
+bool HttpTaskQueue::enqueue(std::function<void()> fn) {
+    // 先计数再入队，工作线程出队时的递减不会先于递增
+    counters_->queued.fetch_add(1);
+    if (queue_.tryPush(fn)) {
+        counters_->accepted.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    counters_->queued.fetch_sub(1);
+
+    // 返回false后由 httplib 关闭套接字；此时还未读取任何请求数据，
+    // 不能先回 503 再关闭（httplib 回写后仍会在长连接上继续读取，未读的请求体会被当作下一个请求解析）
+    counters_->rejected.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void HttpTaskQueue::shutdown() {
+    queue_.close();
+
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+void HttpTaskQueue::workerLoop() {
+    std::function<void()> task;
+    while (queue_.pop(task)) {
+        counters_->queued.fetch_sub(1);
+        counters_->busy.fetch_add(1);
+        task();
+        counters_->busy.fetch_sub(1);
+        task = nullptr;
+    }
+}